@@ -1,33 +1,110 @@
+/*
+ * Single-source shortest paths with negative edge weights.
+ *
+ *   classic  Bellman-Ford: relax every edge, up to V - 1 passes. Stops
+ *            early after the first pass that changes nothing.
+ *   spfa     Queue-based Bellman-Ford (SPFA): only vertices whose distance
+ *            just dropped are queued, and only their out-edges are
+ *            relaxed. Two heuristics pick the next vertex from the deque:
+ *              SLF (small label first) a vertex is pushed to the front
+ *                  instead of the back if its distance is below the
+ *                  front's.
+ *              LLL (large label last) a front vertex whose distance is
+ *                  above the queue average is rotated to the back first.
+ *
+ * Both keep a parent pointer per vertex. With a negative cycle reachable
+ * from the source the distances never settle; the cycle is then read back
+ * from the parent pointers and printed.
+ *
+ * Usage: ./bellman_Ford [classic|spfa]     (default spfa)
+ * Compile with: gcc -O2 -o bellman_Ford bellman_Ford.c
+ */
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <limits.h>
 
 typedef struct {
     int u, v, weight;
 } Edge;
 
-void bellmanFord(int V, int E, Edge edges[], int source) {
-    // Distance array
-    int *dist = (int *)malloc(V * sizeof(int));
+// Follows parent pointers from 'v' for V steps. If the chain is that long
+// it must repeat, and the vertex reached lies on the cycle; returns -1 if
+// the chain ends at the source first, with its edge count in *chainEdges.
+static int findCycleVertex(int V, const int *parent, int v, int *chainEdges) {
+    int steps = 0;
+    while (steps < V && v != -1) {
+        v = parent[v];
+        steps++;
+    }
+    if (chainEdges != NULL)
+        *chainEdges = steps - 1;
+    return v;
+}
+
+/*
+ * Function: extractNegativeCycle
+ * ------------------------------
+ * Writes the cycle through 'start' (a vertex returned by bellmanFordDistances
+ * or spfaDistances) into cycle[], in edge order, and returns its length.
+ * cycle[] needs room for V vertices.
+ */
+int extractNegativeCycle(int V, const int *parent, int start, int *cycle) {
+    int length = 0;
+    int v = start;
+    do {
+        cycle[length++] = v;
+        v = parent[v];
+    } while (v != start && length < V);
+    // Parent pointers run backwards along the edges.
+    for (int i = 0, j = length - 1; i < j; i++, j--) {
+        int t = cycle[i];
+        cycle[i] = cycle[j];
+        cycle[j] = t;
+    }
+    return length;
+}
 
+/*
+ * Function: bellmanFordDistances
+ * ------------------------------
+ * Fills dist[] (INT_MAX if unreachable) and parent[] (-1 for the source
+ * and unreachable vertices). Returns -1, or a vertex on a negative cycle
+ * reachable from the source. 'relaxations' (may be NULL) receives the
+ * number of edges examined.
+ */
+int bellmanFordDistances(int V, int E, const Edge edges[], int source, int *dist, int *parent,
+                         long long *relaxations) {
     //Initialize distances from source to all vertices as infinite and dist[source] = 0
     for (int i = 0; i < V; i++) {
         dist[i] = INT_MAX;
+        parent[i] = -1;
     }
     dist[source] = 0;
 
     //Relax all edges |V| - 1 times
     //A simple shortest path from source to any other vertex can have at most |V|-1 edges
-    for (int i = 0; i < V - 1; i++) {
+    //A pass that changes nothing means every distance is final: stop there
+    long long examined = 0;
+    int changed = 1;
+    for (int i = 0; i < V - 1 && changed; i++) {
+        changed = 0;
         for (int j = 0; j < E; j++) {
             int u = edges[j].u;
             int v = edges[j].v;
             int w = edges[j].weight;
             if (dist[u] != INT_MAX && dist[u] + w < dist[v]) {
                 dist[v] = dist[u] + w;
+                parent[v] = u;
+                changed = 1;
             }
         }
+        examined += E;
     }
+    if (relaxations != NULL)
+        *relaxations = examined;
+    if (!changed)
+        return -1;
 
     // Check for negative-weight cycles
     // If we can still relax an edge, then we have a negative cycle
@@ -36,27 +113,181 @@ void bellmanFord(int V, int E, Edge edges[], int source) {
         int v = edges[j].v;
         int w = edges[j].weight;
         if (dist[u] != INT_MAX && dist[u] + w < dist[v]) {
-            printf("A negative-weight cycle exists in the graph reachable from the source.\n");
-            free(dist);
-            return;
+            parent[v] = u;
+            return findCycleVertex(V, parent, v, NULL);
         }
     }
+    return -1;
+}
+
+/*
+ * Function: spfaDistances
+ * -----------------------
+ * Same contract as bellmanFordDistances(). Negative cycles are found by
+ * counting the edges on each vertex's current path: a path of V edges
+ * repeats a vertex, and a repeated vertex on a path that kept getting
+ * shorter closes a negative cycle. Per-vertex enqueue counts, the usual
+ * FIFO test, do not bound the work once SLF/LLL reorder the queue.
+ */
+int spfaDistances(int V, int E, const Edge edges[], int source, int *dist, int *parent,
+                  long long *relaxations) {
+    // Out-edges of u are edges[byVertex[offset[u] .. offset[u+1])]
+    int *offset = (int *)calloc(V + 1, sizeof(int));
+    int *byVertex = (int *)malloc((E > 0 ? E : 1) * sizeof(int));
+    int *pathEdges = (int *)malloc(V * sizeof(int));
+    int *deque = (int *)malloc(V * sizeof(int));   // also the fill cursor below
+    char *queued = (char *)calloc(V, sizeof(char));
+    if (offset == NULL || byVertex == NULL || pathEdges == NULL || deque == NULL || queued == NULL) {
+        fprintf(stderr, "Memory allocation failed.\n");
+        exit(EXIT_FAILURE);
+    }
+    for (int j = 0; j < E; j++)
+        offset[edges[j].u + 1]++;
+    for (int u = 0; u < V; u++)
+        offset[u + 1] += offset[u];
+    memcpy(deque, offset, V * sizeof(int));
+    for (int j = 0; j < E; j++)
+        byVertex[deque[edges[j].u]++] = j;
 
-    //If no negative cycle, print the distances
-    printf("Shortest distances from vertex %d:\n", source);
     for (int i = 0; i < V; i++) {
-        if (dist[i] == INT_MAX)
-            printf("Vertex %d: INF\n", i);
-        else
-            printf("Vertex %d: %d\n", i, dist[i]);
+        dist[i] = INT_MAX;
+        parent[i] = -1;
     }
+    dist[source] = 0;
+    pathEdges[source] = 0;
+
+    // Circular deque: at most V vertices are queued at once.
+    int head = 0, count = 1;
+    long long queuedSum = 0;    // sum of dist[] over queued vertices, for LLL
+    deque[0] = source;
+    queued[source] = 1;
+
+    long long examined = 0;
+    int cycleVertex = -1;
+    while (count > 0 && cycleVertex < 0) {
+        // LLL: rotate above-average vertices to the back. At least one
+        // queued vertex is at or below the average, so this stops.
+        while ((long long)dist[deque[head]] * count > queuedSum) {
+            int back = head + count < V ? head + count : head + count - V;
+            deque[back] = deque[head];
+            head = head + 1 < V ? head + 1 : 0;
+        }
+        int u = deque[head];
+        head = head + 1 < V ? head + 1 : 0;
+        count--;
+        queued[u] = 0;
+        queuedSum -= dist[u];
+
+        for (int k = offset[u]; k < offset[u + 1]; k++) {
+            const Edge *e = &edges[byVertex[k]];
+            int v = e->v;
+            examined++;
+            if (dist[u] + e->weight >= dist[v])
+                continue;
+            int old = dist[v];
+            dist[v] = dist[u] + e->weight;
+            parent[v] = u;
+            pathEdges[v] = pathEdges[u] + 1;
+            if (pathEdges[v] >= V) {
+                // The recorded path may since have been shortened; only a
+                // chain of V parents is proof. Otherwise recount it.
+                cycleVertex = findCycleVertex(V, parent, v, &pathEdges[v]);
+                if (cycleVertex >= 0)
+                    break;
+            }
+            if (queued[v]) {
+                queuedSum -= (long long)old - dist[v];
+                continue;
+            }
+            // SLF: a smaller label than the front's goes to the front.
+            if (count > 0 && dist[v] < dist[deque[head]]) {
+                head = head > 0 ? head - 1 : V - 1;
+                deque[head] = v;
+            } else {
+                deque[head + count < V ? head + count : head + count - V] = v;
+            }
+            count++;
+            queued[v] = 1;
+            queuedSum += dist[v];
+        }
+    }
+    if (relaxations != NULL)
+        *relaxations = examined;
+
+    free(offset);
+    free(byVertex);
+    free(pathEdges);
+    free(deque);
+    free(queued);
+    return cycleVertex;
+}
+
+typedef int (*ShortestPathFunction)(int V, int E, const Edge edges[], int source, int *dist,
+                                    int *parent, long long *relaxations);
+
+void bellmanFord(int V, int E, Edge edges[], int source, ShortestPathFunction algorithm) {
+    // Distance array
+    int *dist = (int *)malloc(V * sizeof(int));
+    int *parent = (int *)malloc(V * sizeof(int));
+    if (dist == NULL || parent == NULL) {
+        fprintf(stderr, "Memory allocation failed.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    long long relaxations;
+    int cycleVertex = algorithm(V, E, edges, source, dist, parent, &relaxations);
+    if (cycleVertex >= 0) {
+        int *cycle = (int *)malloc(V * sizeof(int));
+        if (cycle == NULL) {
+            fprintf(stderr, "Memory allocation failed.\n");
+            exit(EXIT_FAILURE);
+        }
+        int length = extractNegativeCycle(V, parent, cycleVertex, cycle);
+        long long total = 0;
+        for (int i = 0; i < length; i++) {
+            int u = cycle[i], v = cycle[(i + 1) % length];
+            int best = INT_MAX;
+            for (int j = 0; j < E; j++) {
+                if (edges[j].u == u && edges[j].v == v && edges[j].weight < best)
+                    best = edges[j].weight;
+            }
+            total += best;
+        }
+        printf("A negative-weight cycle exists in the graph reachable from the source:\n");
+        for (int i = 0; i < length; i++)
+            printf("%d -> ", cycle[i]);
+        printf("%d (total weight %lld)\n", cycle[0], total);
+        free(cycle);
+    } else {
+        //If no negative cycle, print the distances
+        printf("Shortest distances from vertex %d:\n", source);
+        for (int i = 0; i < V; i++) {
+            if (dist[i] == INT_MAX)
+                printf("Vertex %d: INF\n", i);
+            else
+                printf("Vertex %d: %d\n", i, dist[i]);
+        }
+    }
+    printf("Edges examined: %lld\n", relaxations);
 
     free(dist);
+    free(parent);
 }
 
-int main() {
+#ifndef BELLMAN_FORD_NO_MAIN
+int main(int argc, char *argv[]) {
     int V, E;
-    int source;   
+    int source;
+    ShortestPathFunction algorithm = spfaDistances;
+
+    if (argc > 1) {
+        if (strcmp(argv[1], "classic") == 0) {
+            algorithm = bellmanFordDistances;
+        } else if (strcmp(argv[1], "spfa") != 0) {
+            fprintf(stderr, "Unknown algorithm '%s' (classic or spfa).\n", argv[1]);
+            return 1;
+        }
+    }
 
     printf("Enter the number of vertices: ");
     scanf("%d", &V);
@@ -76,7 +307,8 @@ int main() {
     }
     printf("Enter the source vertex index: ");
     scanf("%d", &source);
-    bellmanFord(V, E, edges, source);
+    bellmanFord(V, E, edges, source, algorithm);
     free(edges);
     return 0;
 }
+#endif
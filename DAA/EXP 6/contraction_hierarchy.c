@@ -0,0 +1,729 @@
+/*
+ * Contraction hierarchies for repeated point-to-point queries.
+ *
+ * Preprocessing contracts the vertices one at a time, cheapest first.
+ * Contracting v removes it from the remaining graph; for every pair of
+ * remaining neighbours u -> v -> w whose path through v may be the only
+ * shortest u-w path, a shortcut u -> w of the same length is added. A
+ * witness search (a Dijkstra from u that avoids v, bounded in distance and
+ * in settled vertices) skips the shortcut when another path is no longer.
+ *
+ * The order comes from a priority queue keyed on a weighted sum of
+ *   edge difference        shortcuts added - edges removed
+ *   contracted neighbours  so contraction spreads evenly over the graph
+ *   level                  1 + highest level among contracted neighbours,
+ *                          which keeps the hierarchy shallow
+ * Priorities are updated lazily: the popped vertex is re-simulated and goes
+ * back into the queue if it is no longer the cheapest. (Re-simulating every
+ * neighbour after each contraction was 4x slower on grids for no gain.)
+ *
+ * Vertex v gets rank = position in the order. Every edge and shortcut goes
+ * from lower to higher rank in one of two graphs:
+ *   up    u -> w with rank[w] > rank[u]
+ *   down  w -> u for an edge u -> w with rank[u] > rank[w] (reversed)
+ * A shortest s-t path always climbs and then descends in rank, so a query
+ * runs Dijkstra from s on 'up' and from t on 'down' and meets at the top.
+ * Each side stops once its queue minimum reaches the best distance found,
+ * and skips vertices it reached on a provably non-shortest path (stall-on-
+ * demand). On road networks both searches settle a few hundred vertices;
+ * on a 120 x 120 grid with random weights about 300. Shortcuts
+ * remember the vertex they bypass, so the path is unpacked recursively.
+ *
+ * The hierarchy can be saved to disk and loaded without redoing the
+ * preprocessing.
+ *
+ * Usage: ./contraction_hierarchy [graph.gr] [--save file.ch] [--load file.ch]
+ *                                [--verify]
+ *        Queries are read from stdin as 1-based "s t" pairs. --verify
+ *        (needs graph.gr) checks every answer against Dijkstra. Without a
+ *        file the graph and one query are read like dijkstra.c.
+ * Compile with: gcc -O2 -o contraction_hierarchy contraction_hierarchy.c -lm
+ */
+#define POINT_TO_POINT_NO_MAIN
+#include "point_to_point.c"
+
+#include <time.h>
+
+// A witness search gives up after settling this many vertices; the
+// shortcut is then added even if it might be redundant.
+#define WITNESS_SETTLE_LIMIT 500
+
+#define CH_MAGIC "CH01"
+
+// Weights of the priority terms.
+#ifndef PRIORITY_EDGE_DIFF
+#define PRIORITY_EDGE_DIFF 2
+#endif
+#ifndef PRIORITY_DELETED
+#define PRIORITY_DELETED 1
+#endif
+#ifndef PRIORITY_LEVEL
+#define PRIORITY_LEVEL 1
+#endif
+
+typedef struct {
+    int V;
+    int *rank;              // contraction order
+    CsrGraph up, down;
+    int *upMiddle;          // bypassed vertex per edge of 'up', -1 for an original edge
+    int *downMiddle;
+    long long shortcuts;
+} ContractionHierarchy;
+
+// -------------------------- Preprocessing --------------------------
+typedef struct {
+    int vertex;
+    int weight;
+    int middle;
+} ChArc;
+
+typedef struct {
+    ChArc *arcs;
+    int size, capacity;
+} ArcList;
+
+// Adds the arc, or lowers the weight of an existing arc to the same vertex.
+static void arcListSet(ArcList *list, int vertex, int weight, int middle) {
+    for (int i = 0; i < list->size; i++) {
+        if (list->arcs[i].vertex == vertex) {
+            if (weight < list->arcs[i].weight) {
+                list->arcs[i].weight = weight;
+                list->arcs[i].middle = middle;
+            }
+            return;
+        }
+    }
+    if (list->size == list->capacity) {
+        list->capacity = list->capacity ? 2 * list->capacity : 4;
+        list->arcs = (ChArc *)realloc(list->arcs, list->capacity * sizeof(ChArc));
+        if (list->arcs == NULL) {
+            fprintf(stderr, "Memory allocation failed.\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+    list->arcs[list->size].vertex = vertex;
+    list->arcs[list->size].weight = weight;
+    list->arcs[list->size].middle = middle;
+    list->size++;
+}
+
+static void arcListRemove(ArcList *list, int vertex) {
+    for (int i = 0; i < list->size; i++) {
+        if (list->arcs[i].vertex == vertex) {
+            list->arcs[i] = list->arcs[--list->size];
+            return;
+        }
+    }
+}
+
+typedef struct {
+    int V;
+    ArcList *out, *in;      // remaining graph; frozen once a vertex is contracted
+    int *deleted;           // contracted neighbours per vertex
+    int *level;             // 1 + highest level among contracted neighbours
+    int *dist, *stamp;      // witness search
+    int search;
+    DaryHeap heap;
+} ChBuilder;
+
+// Bounded Dijkstra from 'source' in the remaining graph without 'avoid'.
+static void witnessSearch(ChBuilder *b, int source, int avoid, int maxDist) {
+    b->search++;
+    clearDaryHeap(&b->heap);
+    b->stamp[source] = b->search;
+    b->dist[source] = 0;
+    daryHeapDecreaseKey(&b->heap, source, 0);
+    int settled = 0, u, du;
+    while (daryHeapPop(&b->heap, &u, &du)) {
+        if (du > maxDist || ++settled > WITNESS_SETTLE_LIMIT)
+            break;
+        const ArcList *out = &b->out[u];
+        for (int i = 0; i < out->size; i++) {
+            int v = out->arcs[i].vertex;
+            int nd = du + out->arcs[i].weight;
+            if (v == avoid)
+                continue;
+            if (b->stamp[v] != b->search || nd < b->dist[v]) {
+                b->stamp[v] = b->search;
+                b->dist[v] = nd;
+                daryHeapDecreaseKey(&b->heap, v, nd);
+            }
+        }
+    }
+}
+
+/*
+ * Function: contractVertex
+ * ------------------------
+ * Counts the shortcuts that contracting v needs, and adds them unless
+ * 'simulate' is set.
+ */
+static int contractVertex(ChBuilder *b, int v, int simulate) {
+    const ArcList *in = &b->in[v], *out = &b->out[v];
+    int shortcuts = 0;
+    for (int i = 0; i < in->size; i++) {
+        int u = in->arcs[i].vertex, wu = in->arcs[i].weight;
+        int maxOut = -1;
+        for (int j = 0; j < out->size; j++) {
+            if (out->arcs[j].vertex != u && out->arcs[j].weight > maxOut)
+                maxOut = out->arcs[j].weight;
+        }
+        if (maxOut < 0)
+            continue;
+        witnessSearch(b, u, v, wu + maxOut);
+        for (int j = 0; j < out->size; j++) {
+            int w = out->arcs[j].vertex, nd = wu + out->arcs[j].weight;
+            if (w == u || (b->stamp[w] == b->search && b->dist[w] <= nd))
+                continue;
+            shortcuts++;
+            if (!simulate) {
+                arcListSet(&b->out[u], w, nd, v);
+                arcListSet(&b->in[w], u, nd, v);
+            }
+        }
+    }
+    return shortcuts;
+}
+
+static int contractionPriority(ChBuilder *b, int v) {
+    int edgeDifference = contractVertex(b, v, 1) - b->in[v].size - b->out[v].size;
+    return PRIORITY_EDGE_DIFF * edgeDifference + PRIORITY_DELETED * b->deleted[v] +
+           PRIORITY_LEVEL * b->level[v];
+}
+
+// Packs per-vertex arc lists into a CSR graph plus its middle[] array.
+static void packArcs(CsrGraph *g, int **middle, const ArcList *lists, int V) {
+    g->V = V;
+    g->offset = (int *)malloc((V + 1) * sizeof(int));
+    if (g->offset == NULL) {
+        fprintf(stderr, "Memory allocation failed.\n");
+        exit(EXIT_FAILURE);
+    }
+    g->offset[0] = 0;
+    for (int v = 0; v < V; v++)
+        g->offset[v + 1] = g->offset[v] + lists[v].size;
+    g->E = g->offset[V];
+    g->target = (int *)malloc((g->E > 0 ? g->E : 1) * sizeof(int));
+    g->weight = (int *)malloc((g->E > 0 ? g->E : 1) * sizeof(int));
+    *middle = (int *)malloc((g->E > 0 ? g->E : 1) * sizeof(int));
+    if (g->target == NULL || g->weight == NULL || *middle == NULL) {
+        fprintf(stderr, "Memory allocation failed.\n");
+        exit(EXIT_FAILURE);
+    }
+    g->maxWeight = 0;
+    g->negativeWeights = 0;
+    for (int v = 0; v < V; v++) {
+        for (int i = 0; i < lists[v].size; i++) {
+            int e = g->offset[v] + i;
+            g->target[e] = lists[v].arcs[i].vertex;
+            g->weight[e] = lists[v].arcs[i].weight;
+            (*middle)[e] = lists[v].arcs[i].middle;
+            if (g->weight[e] > g->maxWeight)
+                g->maxWeight = g->weight[e];
+        }
+    }
+}
+
+static void countShortcuts(ContractionHierarchy *ch) {
+    ch->shortcuts = 0;
+    for (int e = 0; e < ch->up.E; e++)
+        ch->shortcuts += ch->upMiddle[e] >= 0;
+    for (int e = 0; e < ch->down.E; e++)
+        ch->shortcuts += ch->downMiddle[e] >= 0;
+}
+
+/*
+ * Function: buildContractionHierarchy
+ * -----------------------------------
+ * 'g' must have non-negative weights. Parallel edges keep the lightest one
+ * and self-loops are dropped; neither affects shortest paths.
+ */
+void buildContractionHierarchy(ContractionHierarchy *ch, const CsrGraph *g) {
+    int V = g->V;
+    ChBuilder b;
+    b.V = V;
+    b.out = (ArcList *)calloc(V > 0 ? V : 1, sizeof(ArcList));
+    b.in = (ArcList *)calloc(V > 0 ? V : 1, sizeof(ArcList));
+    b.deleted = (int *)calloc(V > 0 ? V : 1, sizeof(int));
+    b.level = (int *)calloc(V > 0 ? V : 1, sizeof(int));
+    b.dist = (int *)malloc((V > 0 ? V : 1) * sizeof(int));
+    b.stamp = (int *)calloc(V > 0 ? V : 1, sizeof(int));
+    ch->rank = (int *)malloc((V > 0 ? V : 1) * sizeof(int));
+    if (b.out == NULL || b.in == NULL || b.deleted == NULL || b.level == NULL || b.dist == NULL || b.stamp == NULL ||
+        ch->rank == NULL) {
+        fprintf(stderr, "Memory allocation failed.\n");
+        exit(EXIT_FAILURE);
+    }
+    b.search = 0;
+    initDaryHeap(&b.heap, V, DARY_HEAP_ARITY);
+    for (int u = 0; u < V; u++) {
+        for (int e = g->offset[u]; e < g->offset[u + 1]; e++) {
+            int v = g->target[e];
+            if (v != u) {
+                arcListSet(&b.out[u], v, g->weight[e], -1);
+                arcListSet(&b.in[v], u, g->weight[e], -1);
+            }
+        }
+    }
+
+    // The witness searches share b.heap, so the order lives in its own heap.
+    DaryHeap order;
+    initDaryHeap(&order, V, DARY_HEAP_ARITY);
+    for (int v = 0; v < V; v++)
+        daryHeapDecreaseKey(&order, v, contractionPriority(&b, v));
+    ch->V = V;
+    int next = 0, v, key;
+    while (daryHeapPop(&order, &v, &key)) {
+        int priority = contractionPriority(&b, v);
+        if (order.size > 0 && priority > order.nodes[0].key) {
+            daryHeapDecreaseKey(&order, v, priority);
+            continue;
+        }
+        contractVertex(&b, v, 0);
+        ch->rank[v] = next++;
+        // Detach v: its own lists now hold exactly its edges to
+        // higher-ranked vertices and become part of the hierarchy.
+        for (int i = 0; i < b.in[v].size; i++)
+            arcListRemove(&b.out[b.in[v].arcs[i].vertex], v);
+        for (int i = 0; i < b.out[v].size; i++)
+            arcListRemove(&b.in[b.out[v].arcs[i].vertex], v);
+        // Update the neighbours' priority terms; their queue keys are
+        // refreshed lazily when they reach the top.
+        for (int side = 0; side < 2; side++) {
+            const ArcList *arcs = side == 0 ? &b.in[v] : &b.out[v];
+            for (int i = 0; i < arcs->size; i++) {
+                int n = arcs->arcs[i].vertex;
+                b.deleted[n]++;
+                if (b.level[n] < b.level[v] + 1)
+                    b.level[n] = b.level[v] + 1;
+            }
+        }
+    }
+    packArcs(&ch->up, &ch->upMiddle, b.out, V);
+    packArcs(&ch->down, &ch->downMiddle, b.in, V);
+    countShortcuts(ch);
+
+    freeDaryHeap(&order);
+    freeDaryHeap(&b.heap);
+    for (int u = 0; u < V; u++) {
+        free(b.out[u].arcs);
+        free(b.in[u].arcs);
+    }
+    free(b.out);
+    free(b.in);
+    free(b.deleted);
+    free(b.level);
+    free(b.dist);
+    free(b.stamp);
+}
+
+void freeContractionHierarchy(ContractionHierarchy *ch) {
+    free(ch->rank);
+    freeCsrGraph(&ch->up);
+    freeCsrGraph(&ch->down);
+    free(ch->upMiddle);
+    free(ch->downMiddle);
+}
+
+// -------------------------- Serialization --------------------------
+static int writeInts(FILE *out, const int *values, size_t count) {
+    return fwrite(values, sizeof(int), count, out) == count ? 0 : -1;
+}
+
+static int readInts(FILE *in, int *values, size_t count) {
+    return fread(values, sizeof(int), count, in) == count ? 0 : -1;
+}
+
+static int writeChGraph(FILE *out, const CsrGraph *g, const int *middle) {
+    if (writeInts(out, &g->E, 1) != 0 || writeInts(out, g->offset, g->V + 1) != 0 ||
+        writeInts(out, g->target, g->E) != 0 || writeInts(out, g->weight, g->E) != 0 ||
+        writeInts(out, middle, g->E) != 0)
+        return -1;
+    return 0;
+}
+
+static int readChGraph(FILE *in, CsrGraph *g, int **middle, int V) {
+    int E;
+    if (readInts(in, &E, 1) != 0 || E < 0)
+        return -1;
+    g->V = V;
+    g->E = E;
+    g->offset = (int *)malloc((V + 1) * sizeof(int));
+    g->target = (int *)malloc((E > 0 ? E : 1) * sizeof(int));
+    g->weight = (int *)malloc((E > 0 ? E : 1) * sizeof(int));
+    *middle = (int *)malloc((E > 0 ? E : 1) * sizeof(int));
+    if (g->offset == NULL || g->target == NULL || g->weight == NULL || *middle == NULL) {
+        fprintf(stderr, "Memory allocation failed.\n");
+        exit(EXIT_FAILURE);
+    }
+    if (readInts(in, g->offset, V + 1) != 0 || readInts(in, g->target, E) != 0 ||
+        readInts(in, g->weight, E) != 0 || readInts(in, *middle, E) != 0 ||
+        g->offset[0] != 0 || g->offset[V] != E)
+        return -1;
+    g->maxWeight = 0;
+    g->negativeWeights = 0;
+    for (int v = 0; v < V; v++) {
+        if (g->offset[v + 1] < g->offset[v])
+            return -1;
+    }
+    for (int e = 0; e < E; e++) {
+        if (g->target[e] < 0 || g->target[e] >= V || (*middle)[e] < -1 || (*middle)[e] >= V ||
+            g->weight[e] < 0)
+            return -1;
+        if (g->weight[e] > g->maxWeight)
+            g->maxWeight = g->weight[e];
+    }
+    return 0;
+}
+
+/*
+ * Function: saveContractionHierarchy
+ * ----------------------------------
+ * Binary format in native byte order: the magic "CH01", V, rank[V], then
+ * for 'up' and 'down' in turn E, offset[V + 1], target[E], weight[E] and
+ * middle[E]. Returns 0 on success, -1 on a write error.
+ */
+int saveContractionHierarchy(const ContractionHierarchy *ch, FILE *out) {
+    if (fwrite(CH_MAGIC, 1, 4, out) != 4 || writeInts(out, &ch->V, 1) != 0 ||
+        writeInts(out, ch->rank, ch->V) != 0 || writeChGraph(out, &ch->up, ch->upMiddle) != 0 ||
+        writeChGraph(out, &ch->down, ch->downMiddle) != 0)
+        return -1;
+    return 0;
+}
+
+// Returns 0 on success, -1 if the file is truncated or not a hierarchy.
+int loadContractionHierarchy(ContractionHierarchy *ch, FILE *in) {
+    char magic[4];
+    int V;
+    memset(ch, 0, sizeof(*ch));
+    if (fread(magic, 1, 4, in) != 4 || memcmp(magic, CH_MAGIC, 4) != 0 ||
+        readInts(in, &V, 1) != 0 || V < 0)
+        return -1;
+    ch->V = V;
+    ch->rank = (int *)malloc((V > 0 ? V : 1) * sizeof(int));
+    if (ch->rank == NULL) {
+        fprintf(stderr, "Memory allocation failed.\n");
+        exit(EXIT_FAILURE);
+    }
+    if (readInts(in, ch->rank, V) != 0 ||
+        readChGraph(in, &ch->up, &ch->upMiddle, V) != 0 ||
+        readChGraph(in, &ch->down, &ch->downMiddle, V) != 0) {
+        freeContractionHierarchy(ch);
+        return -1;
+    }
+    countShortcuts(ch);
+    return 0;
+}
+
+// -------------------------- Queries --------------------------
+// Vertex bypassed by the hierarchy edge a -> b (-1 for an original edge).
+static int arcMiddle(const ContractionHierarchy *ch, int a, int b) {
+    const CsrGraph *g = ch->rank[a] < ch->rank[b] ? &ch->up : &ch->down;
+    const int *middle = ch->rank[a] < ch->rank[b] ? ch->upMiddle : ch->downMiddle;
+    int from = ch->rank[a] < ch->rank[b] ? a : b, to = from == a ? b : a;
+    for (int e = g->offset[from]; e < g->offset[from + 1]; e++) {
+        if (g->target[e] == to)
+            return middle[e];
+    }
+    return -1;
+}
+
+// Replaces the shortcuts in result->path by the vertices they bypass.
+static void unpackPath(const ContractionHierarchy *ch, PathResult *result) {
+    int capacity = result->length > 0 ? 2 * result->length : 1, length = 0;
+    int *path = (int *)malloc(capacity * sizeof(int));
+    int stackCapacity = 64, top = 0;
+    int *stack = (int *)malloc(2 * stackCapacity * sizeof(int));
+    if (path == NULL || stack == NULL) {
+        fprintf(stderr, "Memory allocation failed.\n");
+        exit(EXIT_FAILURE);
+    }
+    path[length++] = result->path[0];
+    for (int i = 1; i < result->length; i++) {
+        stack[0] = result->path[i - 1];
+        stack[1] = result->path[i];
+        top = 1;
+        while (top > 0) {
+            top--;
+            int a = stack[2 * top], b = stack[2 * top + 1];
+            int m = arcMiddle(ch, a, b);
+            if (m < 0) {
+                if (length == capacity) {
+                    capacity *= 2;
+                    path = (int *)realloc(path, capacity * sizeof(int));
+                    if (path == NULL) {
+                        fprintf(stderr, "Memory allocation failed.\n");
+                        exit(EXIT_FAILURE);
+                    }
+                }
+                path[length++] = b;
+                continue;
+            }
+            if (top + 2 > stackCapacity) {
+                stackCapacity *= 2;
+                stack = (int *)realloc(stack, 2 * stackCapacity * sizeof(int));
+                if (stack == NULL) {
+                    fprintf(stderr, "Memory allocation failed.\n");
+                    exit(EXIT_FAILURE);
+                }
+            }
+            // Push m -> b first so a -> m is unpacked first.
+            stack[2 * top] = m;
+            stack[2 * top + 1] = b;
+            stack[2 * top + 2] = a;
+            stack[2 * top + 3] = m;
+            top += 2;
+        }
+    }
+    free(stack);
+    free(result->path);
+    result->path = path;
+    result->length = length;
+}
+
+/*
+ * Function: contractionHierarchyQuery
+ * -----------------------------------
+ * Upward search from s on 'up' and from t on 'down', alternating by the
+ * smaller queue minimum. A side stops once its minimum reaches mu, the best
+ * s-t distance through a vertex reached by both; unlike plain bidirectional
+ * Dijkstra the two sides cannot stop on minF + minB >= mu, because neither
+ * search alone sees the graph in distance order. 'ws' must be sized for
+ * ch->V.
+ */
+int contractionHierarchyQuery(const ContractionHierarchy *ch, QueryWorkspace *ws, int s, int t,
+                              PathResult *result) {
+    SearchSide *fw = &ws->forward, *bw = &ws->backward;
+    beginQuery(ws);
+    int q = ws->query;
+    result->path = NULL;
+    result->length = 0;
+    result->settled = 0;
+
+    sideSet(fw, q, s, 0, -1);
+    sideSet(bw, q, t, 0, -1);
+    daryHeapDecreaseKey(&fw->heap, s, 0);
+    daryHeapDecreaseKey(&bw->heap, t, 0);
+    int mu = s == t ? 0 : INT_MAX;
+    int meet = s == t ? s : -1;
+
+    for (;;) {
+        int minF = fw->heap.size > 0 ? fw->heap.nodes[0].key : INT_MAX;
+        int minB = bw->heap.size > 0 ? bw->heap.nodes[0].key : INT_MAX;
+        if (minF >= mu && minB >= mu)
+            break;
+        int forward = minF <= minB;
+        SearchSide *side = forward ? fw : bw, *other = forward ? bw : fw;
+        const CsrGraph *graph = forward ? &ch->up : &ch->down;
+        const CsrGraph *opposite = forward ? &ch->down : &ch->up;
+        int u, du;
+        daryHeapPop(&side->heap, &u, &du);
+        result->settled++;
+        // Stall-on-demand: if a higher vertex already reached by this side
+        // has an edge down to u giving a shorter distance, du is not a
+        // shortest distance and u cannot lie on the answer's upward path.
+        int stalled = 0;
+        for (int e = opposite->offset[u]; e < opposite->offset[u + 1] && !stalled; e++) {
+            int dw = sideDist(side, q, opposite->target[e]);
+            stalled = dw != INT_MAX && dw + opposite->weight[e] < du;
+        }
+        if (stalled)
+            continue;
+        for (int e = graph->offset[u]; e < graph->offset[u + 1]; e++) {
+            int v = graph->target[e];
+            int nd = du + graph->weight[e];
+            if (nd < sideDist(side, q, v)) {
+                sideSet(side, q, v, nd, u);
+                daryHeapDecreaseKey(&side->heap, v, nd);
+            }
+            int dv = sideDist(other, q, v);
+            if (dv != INT_MAX && nd + dv < mu) {
+                mu = nd + dv;
+                meet = v;
+            }
+        }
+    }
+    result->distance = mu;
+    if (meet >= 0) {
+        buildPath(ws, meet, 1, result);
+        unpackPath(ch, result);
+    }
+    return mu;
+}
+
+#ifndef CONTRACTION_HIERARCHY_NO_MAIN
+static double secondsSince(const struct timespec *start) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (now.tv_sec - start->tv_sec) + (now.tv_nsec - start->tv_nsec) * 1e-9;
+}
+
+int main(int argc, char *argv[]) {
+    const char *graphPath = NULL, *savePath = NULL, *loadPath = NULL;
+    int verify = 0;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--save") == 0 && i + 1 < argc)
+            savePath = argv[++i];
+        else if (strcmp(argv[i], "--load") == 0 && i + 1 < argc)
+            loadPath = argv[++i];
+        else if (strcmp(argv[i], "--verify") == 0)
+            verify = 1;
+        else
+            graphPath = argv[i];
+    }
+    if (verify && graphPath == NULL) {
+        fprintf(stderr, "--verify needs the graph file.\n");
+        return 1;
+    }
+
+    EdgeList list;
+    CsrGraph g;
+    int haveGraph = graphPath != NULL || loadPath == NULL;
+    if (graphPath != NULL) {
+        FILE *in = fopen(graphPath, "r");
+        if (in == NULL) {
+            perror(graphPath);
+            return 1;
+        }
+        if (readDimacsGraph(in, &list) != 0) {
+            fprintf(stderr, "%s: not a valid DIMACS shortest-path file.\n", graphPath);
+            return 1;
+        }
+        fclose(in);
+    } else if (loadPath == NULL) {
+        int V, E;
+        printf("Enter the number of vertices: ");
+        if (scanf("%d", &V) != 1 || V < 0) {
+            fprintf(stderr, "Invalid number of vertices.\n");
+            return 1;
+        }
+        printf("Enter the number of edges: ");
+        if (scanf("%d", &E) != 1 || E < 0) {
+            fprintf(stderr, "Invalid number of edges.\n");
+            return 1;
+        }
+        initEdgeList(&list, V);
+        printf("Enter each edge in the format: src dest weight\n");
+        for (int i = 0; i < E; i++) {
+            int u, v, w;
+            if (scanf("%d %d %d", &u, &v, &w) != 3) {
+                fprintf(stderr, "Invalid edge.\n");
+                freeEdgeList(&list);
+                return 1;
+            }
+            if (addWeightedEdge(&list, u, v, w) != 0) {
+                fprintf(stderr, "Edge %d -> %d is out of range (vertices are 0..%d).\n", u, v, V - 1);
+                freeEdgeList(&list);
+                return 1;
+            }
+        }
+    }
+    if (haveGraph) {
+        buildCsrGraph(&g, &list);
+        freeEdgeList(&list);
+        if (g.negativeWeights) {
+            fprintf(stderr, "Contraction hierarchies need non-negative edge weights.\n");
+            return 1;
+        }
+    }
+
+    ContractionHierarchy ch;
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    if (loadPath != NULL) {
+        FILE *in = fopen(loadPath, "rb");
+        if (in == NULL) {
+            perror(loadPath);
+            return 1;
+        }
+        if (loadContractionHierarchy(&ch, in) != 0) {
+            fprintf(stderr, "%s: not a valid contraction hierarchy.\n", loadPath);
+            return 1;
+        }
+        fclose(in);
+        if (haveGraph && ch.V != g.V) {
+            fprintf(stderr, "%s has %d vertices, the graph %d.\n", loadPath, ch.V, g.V);
+            return 1;
+        }
+        fprintf(stderr, "Loaded %d vertices, %lld shortcuts in %.3f s\n", ch.V, ch.shortcuts,
+                secondsSince(&start));
+    } else {
+        buildContractionHierarchy(&ch, &g);
+        fprintf(stderr, "Contracted %d vertices, %d edges + %lld shortcuts in %.3f s\n", ch.V, g.E,
+                ch.shortcuts, secondsSince(&start));
+    }
+    if (savePath != NULL) {
+        FILE *out = fopen(savePath, "wb");
+        if (out == NULL || saveContractionHierarchy(&ch, out) != 0 || fclose(out) != 0) {
+            fprintf(stderr, "%s: write failed.\n", savePath);
+            return 1;
+        }
+    }
+
+    QueryWorkspace ws, check;
+    initQueryWorkspace(&ws, ch.V);
+    if (verify)
+        initQueryWorkspace(&check, g.V);
+    int s, t, status = 0, queries = 0;
+    long long settled = 0;
+    double seconds = 0;
+    int interactive = graphPath == NULL && loadPath == NULL;
+    if (interactive) {
+        printf("Enter the source vertex: ");
+        if (scanf("%d", &s) != 1)
+            s = -1;
+        printf("Enter the target vertex: ");
+        if (scanf("%d", &t) != 1)
+            t = -1;
+    }
+    int base = interactive ? 0 : 1;
+    while (interactive || scanf("%d %d", &s, &t) == 2) {
+        s -= base;
+        t -= base;
+        if (s < 0 || s >= ch.V || t < 0 || t >= ch.V) {
+            fprintf(stderr, "Vertex out of range.\n");
+            status = 1;
+        } else {
+            PathResult result;
+            clock_gettime(CLOCK_MONOTONIC, &start);
+            contractionHierarchyQuery(&ch, &ws, s, t, &result);
+            seconds += secondsSince(&start);
+            queries++;
+            settled += result.settled;
+            if (result.distance == INT_MAX) {
+                printf("%d -> %d: unreachable (%lld settled)\n", s + base, t + base, result.settled);
+            } else {
+                printf("%d -> %d: distance %d, %d vertices on path, %lld settled\nPath:", s + base,
+                       t + base, result.distance, result.length, result.settled);
+                for (int i = 0; i < result.length; i++)
+                    printf(" %d", result.path[i] + base);
+                printf("\n");
+            }
+            if (verify) {
+                PathResult expected;
+                dijkstraPointToPoint(&g, &check, s, t, &expected);
+                if (expected.distance != result.distance) {
+                    fprintf(stderr, "%d -> %d: Dijkstra gives %d.\n", s + base, t + base,
+                            expected.distance);
+                    status = 1;
+                }
+                free(expected.path);
+            }
+            free(result.path);
+        }
+        if (interactive)
+            break;
+    }
+    if (queries > 0)
+        fprintf(stderr, "%d queries: %.1f us and %.1f settled vertices per query\n", queries,
+                seconds * 1e6 / queries, (double)settled / queries);
+
+    freeQueryWorkspace(&ws);
+    if (verify)
+        freeQueryWorkspace(&check);
+    freeContractionHierarchy(&ch);
+    if (haveGraph)
+        freeCsrGraph(&g);
+    return status;
+}
+#endif
@@ -0,0 +1,271 @@
+#ifndef CSR_GRAPH_H
+#define CSR_GRAPH_H
+
+/*
+ * Weighted directed graph in compressed sparse row (CSR) form.
+ *
+ * The out-edges of u are target[offset[u] .. offset[u+1]) with matching
+ * weight[] entries: three flat arrays instead of one malloc'd node per
+ * edge, so scanning a vertex's edges is a sequential read and the graph
+ * can be shared read-only between threads.
+ *
+ * Graphs are collected as an EdgeList and converted with buildCsrGraph()
+ * (or buildReverseCsrGraph() for the in-edges). readDimacsGraph() loads the
+ * DIMACS shortest-path format used for road networks (vertices are 1-based
+ * in the file, 0-based here):
+ *   c <comment>
+ *   p sp <nodes> <arcs>
+ *   a <from> <to> <weight>
+ * and readDimacsCoordinates() the matching coordinate file:
+ *   p aux sp co <nodes>
+ *   v <id> <x> <y>
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct {
+    int u, v, w;
+} WeightedEdge;
+
+typedef struct {
+    int V;
+    int E;
+    int capacity;
+    WeightedEdge *edges;
+} EdgeList;
+
+typedef struct {
+    int V, E;
+    int *offset;            // V + 1 entries
+    int *target;            // E entries, grouped by source
+    int *weight;            // E entries
+    int maxWeight;          // largest edge weight (0 if there are no edges)
+    int negativeWeights;    // 1 if some weight is < 0
+} CsrGraph;
+
+void initEdgeList(EdgeList *list, int V) {
+    list->V = V;
+    list->E = 0;
+    list->capacity = 0;
+    list->edges = NULL;
+}
+
+// Appends u -> v. Returns 0, or -1 (and adds nothing) if u or v is not a
+// vertex in [0, V).
+int addWeightedEdge(EdgeList *list, int u, int v, int w) {
+    if (u < 0 || u >= list->V || v < 0 || v >= list->V)
+        return -1;
+    if (list->E == list->capacity) {
+        list->capacity = list->capacity ? 2 * list->capacity : 64;
+        list->edges = (WeightedEdge *)realloc(list->edges, list->capacity * sizeof(WeightedEdge));
+        if (list->edges == NULL) {
+            fprintf(stderr, "Memory allocation failed.\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+    list->edges[list->E].u = u;
+    list->edges[list->E].v = v;
+    list->edges[list->E].w = w;
+    list->E++;
+    return 0;
+}
+
+void freeEdgeList(EdgeList *list) {
+    free(list->edges);
+    list->edges = NULL;
+    list->E = list->capacity = 0;
+}
+
+// Counting sort of the edges by source (by target if 'reverse'); edges of
+// one vertex keep their input order.
+static void buildCsr(CsrGraph *g, const EdgeList *list, int reverse) {
+    int V = list->V, E = list->E;
+    g->V = V;
+    g->E = E;
+    g->offset = (int *)calloc(V + 1, sizeof(int));
+    g->target = (int *)malloc((E > 0 ? E : 1) * sizeof(int));
+    g->weight = (int *)malloc((E > 0 ? E : 1) * sizeof(int));
+    if (g->offset == NULL || g->target == NULL || g->weight == NULL) {
+        fprintf(stderr, "Memory allocation failed.\n");
+        exit(EXIT_FAILURE);
+    }
+    g->maxWeight = 0;
+    g->negativeWeights = 0;
+    for (int i = 0; i < E; i++) {
+        g->offset[(reverse ? list->edges[i].v : list->edges[i].u) + 1]++;
+        if (list->edges[i].w > g->maxWeight)
+            g->maxWeight = list->edges[i].w;
+        if (list->edges[i].w < 0)
+            g->negativeWeights = 1;
+    }
+    for (int u = 0; u < V; u++)
+        g->offset[u + 1] += g->offset[u];
+    int *next = (int *)malloc((V > 0 ? V : 1) * sizeof(int));
+    if (next == NULL) {
+        fprintf(stderr, "Memory allocation failed.\n");
+        exit(EXIT_FAILURE);
+    }
+    memcpy(next, g->offset, V * sizeof(int));
+    for (int i = 0; i < E; i++) {
+        const WeightedEdge *e = &list->edges[i];
+        int slot = next[reverse ? e->v : e->u]++;
+        g->target[slot] = reverse ? e->u : e->v;
+        g->weight[slot] = e->w;
+    }
+    free(next);
+}
+
+void buildCsrGraph(CsrGraph *g, const EdgeList *list) {
+    buildCsr(g, list, 0);
+}
+
+// The transpose: the out-edges of v are the in-edges of v in 'list'.
+void buildReverseCsrGraph(CsrGraph *g, const EdgeList *list) {
+    buildCsr(g, list, 1);
+}
+
+void freeCsrGraph(CsrGraph *g) {
+    free(g->offset);
+    free(g->target);
+    free(g->weight);
+}
+
+// -------------------------- DIMACS reader --------------------------
+typedef struct {
+    FILE *in;
+    char buffer[1 << 16];
+    size_t pos, len;
+} GraphReader;
+
+static int graphGet(GraphReader *r) {
+    if (r->pos == r->len) {
+        r->len = fread(r->buffer, 1, sizeof(r->buffer), r->in);
+        r->pos = 0;
+        if (r->len == 0)
+            return EOF;
+    }
+    return (unsigned char)r->buffer[r->pos++];
+}
+
+static void graphSkipLine(GraphReader *r) {
+    int c;
+    while ((c = graphGet(r)) != EOF && c != '\n')
+        ;
+}
+
+// Reads the next (optionally negative) integer on the current line.
+// Returns 0 at end of line or file.
+static int graphInt(GraphReader *r, long *out) {
+    int c;
+    do {
+        c = graphGet(r);
+    } while (c == ' ' || c == '\t' || c == '\r');
+    int negative = 0;
+    if (c == '-') {
+        negative = 1;
+        c = graphGet(r);
+    }
+    if (c < '0' || c > '9') {
+        if (c == '\n')
+            r->pos--;   // leave the newline for graphSkipLine()
+        return 0;
+    }
+    long value = 0;
+    while (c >= '0' && c <= '9') {
+        value = value * 10 + (c - '0');
+        c = graphGet(r);
+    }
+    if (c == '\n')
+        r->pos--;
+    *out = negative ? -value : value;
+    return 1;
+}
+
+/*
+ * Function: readDimacsGraph
+ * -------------------------
+ * Loads a DIMACS "p sp" file into 'list' (initialised here). Returns 0 on
+ * success, -1 if the problem line is missing or an arc is malformed.
+ */
+int readDimacsGraph(FILE *in, EdgeList *list) {
+    GraphReader *r = (GraphReader *)malloc(sizeof(GraphReader));
+    if (r == NULL) {
+        fprintf(stderr, "Memory allocation failed.\n");
+        exit(EXIT_FAILURE);
+    }
+    r->in = in;
+    r->pos = r->len = 0;
+    int haveProblem = 0, status = 0;
+    int c;
+    while (status == 0 && (c = graphGet(r)) != EOF) {
+        if (c == 'p') {
+            char kind[8] = {0};
+            int k = 0;
+            while ((c = graphGet(r)) == ' ')
+                ;
+            while (c != EOF && c != ' ' && k < 7) {
+                kind[k++] = (char)c;
+                c = graphGet(r);
+            }
+            long n, m;
+            if (strcmp(kind, "sp") != 0 || !graphInt(r, &n) || !graphInt(r, &m) || n < 0) {
+                status = -1;
+                break;
+            }
+            initEdgeList(list, (int)n);
+            haveProblem = 1;
+        } else if (c == 'a') {
+            long u, v, w;
+            if (!haveProblem || !graphInt(r, &u) || !graphInt(r, &v) || !graphInt(r, &w) ||
+                u < 1 || u > list->V || v < 1 || v > list->V) {
+                status = -1;
+                break;
+            }
+            addWeightedEdge(list, (int)u - 1, (int)v - 1, (int)w);
+        }
+        if (c != '\n')
+            graphSkipLine(r);
+    }
+    free(r);
+    if (!haveProblem)
+        status = -1;
+    return status;
+}
+
+/*
+ * Function: readDimacsCoordinates
+ * -------------------------------
+ * Reads "v <id> <x> <y>" lines into x[0..V) and y[0..V). Returns the number
+ * of vertices given coordinates, or -1 on a malformed line.
+ */
+int readDimacsCoordinates(FILE *in, int V, double *x, double *y) {
+    GraphReader *r = (GraphReader *)malloc(sizeof(GraphReader));
+    if (r == NULL) {
+        fprintf(stderr, "Memory allocation failed.\n");
+        exit(EXIT_FAILURE);
+    }
+    r->in = in;
+    r->pos = r->len = 0;
+    int count = 0;
+    int c;
+    while ((c = graphGet(r)) != EOF) {
+        if (c == 'v') {
+            long id, vx, vy;
+            if (!graphInt(r, &id) || !graphInt(r, &vx) || !graphInt(r, &vy) || id < 1 || id > V) {
+                count = -1;
+                break;
+            }
+            x[id - 1] = (double)vx;
+            y[id - 1] = (double)vy;
+            count++;
+        }
+        if (c != '\n')
+            graphSkipLine(r);
+    }
+    free(r);
+    return count;
+}
+
+#endif
@@ -0,0 +1,148 @@
+#ifndef DARY_HEAP_H
+#define DARY_HEAP_H
+
+/*
+ * Indexed d-ary min-heap with decrease-key.
+ *
+ * position[v] records where vertex v sits in the heap (-1 if absent), so a
+ * shorter distance updates v in place instead of inserting a duplicate:
+ * the heap never holds more than one entry per vertex, i.e. at most V.
+ *
+ * With d children per node the heap is log_d(V) levels deep, so sift-up
+ * (decrease-key, the common operation in Dijkstra) does fewer steps than a
+ * binary heap. Sift-down scans the d children, which sit next to each other
+ * in memory. The arity must be a power of two so index arithmetic is
+ * shifts, and the array is laid out so every group of siblings starts on a
+ * d * sizeof(DaryNode) boundary within a 64-byte aligned block: with d = 4
+ * a sibling group is half a cache line, with d = 8 exactly one, and no
+ * group ever straddles two lines.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#ifndef DARY_HEAP_ARITY
+#define DARY_HEAP_ARITY 4
+#endif
+
+#define CACHE_LINE 64
+
+typedef struct {
+    int key;
+    int vertex;
+} DaryNode;
+
+typedef struct {
+    DaryNode *nodes;    // nodes[0] is the root; children of i are nodes[d*i+1 .. d*i+d]
+    DaryNode *block;    // aligned allocation that 'nodes' points into
+    int *position;      // position[v] = index of v in nodes[], -1 if not queued
+    int size;
+    int capacity;       // number of vertices
+    int shift;          // log2(arity)
+} DaryHeap;
+
+// Sets up an empty heap for vertices 0..capacity-1. 'arity' must be a power
+// of two between 2 and CACHE_LINE / sizeof(DaryNode).
+void initDaryHeap(DaryHeap *heap, int capacity, int arity) {
+    int shift = 0;
+    while ((1 << shift) < arity)
+        shift++;
+    if ((1 << shift) != arity || arity < 2 || arity * (int)sizeof(DaryNode) > CACHE_LINE) {
+        fprintf(stderr, "Heap arity must be a power of two from 2 to %d.\n",
+                CACHE_LINE / (int)sizeof(DaryNode));
+        exit(EXIT_FAILURE);
+    }
+    // Offset the root by arity - 1 slots: the first child of node i, index
+    // d*i+1, then lands on slot d*(i+1) of the aligned block.
+    size_t slots = (size_t)capacity + arity - 1;
+    size_t bytes = (slots * sizeof(DaryNode) + CACHE_LINE - 1) / CACHE_LINE * CACHE_LINE;
+    heap->block = (DaryNode *)aligned_alloc(CACHE_LINE, bytes);
+    heap->position = (int *)malloc((capacity > 0 ? capacity : 1) * sizeof(int));
+    if (heap->block == NULL || heap->position == NULL) {
+        fprintf(stderr, "Memory allocation failed.\n");
+        exit(EXIT_FAILURE);
+    }
+    heap->nodes = heap->block + (arity - 1);
+    for (int v = 0; v < capacity; v++)
+        heap->position[v] = -1;
+    heap->size = 0;
+    heap->capacity = capacity;
+    heap->shift = shift;
+}
+
+// Empties the heap in O(size), leaving the position map all -1 again.
+void clearDaryHeap(DaryHeap *heap) {
+    for (int i = 0; i < heap->size; i++)
+        heap->position[heap->nodes[i].vertex] = -1;
+    heap->size = 0;
+}
+
+void freeDaryHeap(DaryHeap *heap) {
+    free(heap->block);
+    free(heap->position);
+}
+
+static void darySiftUp(DaryHeap *heap, int idx, DaryNode node) {
+    while (idx > 0) {
+        int parent = (idx - 1) >> heap->shift;
+        if (heap->nodes[parent].key <= node.key)
+            break;
+        heap->nodes[idx] = heap->nodes[parent];
+        heap->position[heap->nodes[idx].vertex] = idx;
+        idx = parent;
+    }
+    heap->nodes[idx] = node;
+    heap->position[node.vertex] = idx;
+}
+
+static void darySiftDown(DaryHeap *heap, int idx, DaryNode node) {
+    int arity = 1 << heap->shift;
+    for (;;) {
+        int first = (idx << heap->shift) + 1;
+        if (first >= heap->size)
+            break;
+        int last = first + arity < heap->size ? first + arity : heap->size;
+        int best = first;
+        for (int c = first + 1; c < last; c++) {
+            if (heap->nodes[c].key < heap->nodes[best].key)
+                best = c;
+        }
+        if (heap->nodes[best].key >= node.key)
+            break;
+        heap->nodes[idx] = heap->nodes[best];
+        heap->position[heap->nodes[idx].vertex] = idx;
+        idx = best;
+    }
+    heap->nodes[idx] = node;
+    heap->position[node.vertex] = idx;
+}
+
+// Inserts 'vertex' with 'key', or lowers its key if it is already queued
+// with a larger one. Returns 1 if the heap changed.
+int daryHeapDecreaseKey(DaryHeap *heap, int vertex, int key) {
+    int idx = heap->position[vertex];
+    if (idx < 0) {
+        idx = heap->size++;
+    } else if (heap->nodes[idx].key <= key) {
+        return 0;
+    }
+    DaryNode node = {key, vertex};
+    darySiftUp(heap, idx, node);
+    return 1;
+}
+
+// Removes the entry with the smallest key. Returns 0 if the heap is empty.
+int daryHeapPop(DaryHeap *heap, int *vertex, int *key) {
+    if (heap->size == 0)
+        return 0;
+    DaryNode root = heap->nodes[0];
+    heap->position[root.vertex] = -1;
+    heap->size--;
+    if (heap->size > 0)
+        darySiftDown(heap, 0, heap->nodes[heap->size]);
+    *vertex = root.vertex;
+    *key = root.key;
+    return 1;
+}
+
+#endif
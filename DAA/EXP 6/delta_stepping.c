@@ -0,0 +1,412 @@
+/*
+ * Delta-stepping single-source shortest paths (Meyer & Sanders).
+ *
+ * Tentative distances are grouped into buckets of width delta: bucket i
+ * holds vertices with dist in [i * delta, (i + 1) * delta). The smallest
+ * non-empty bucket is settled in rounds:
+ *
+ *   light rounds  every vertex of the bucket relaxes its light edges
+ *                 (w <= delta), in parallel. Targets that improve and land
+ *                 in the same bucket form the next round; repeat until the
+ *                 bucket stays empty.
+ *   heavy round   every vertex settled in the bucket relaxes its heavy
+ *                 edges (w > delta) once. These always land in later
+ *                 buckets, so one round suffices.
+ *
+ * Relaxations from different threads race on the same dist[] entry, so a
+ * distance is lowered with a compare-and-swap fetch-min: the smallest value
+ * always wins and no update is lost. Shortest distances are unique, so the
+ * result is identical to dijkstra() no matter how the races interleave
+ * (--verify checks this).
+ *
+ * Threads stay alive for the whole search and meet at a barrier after each
+ * round; thread 0 then files the improved vertices into buckets. Pending
+ * buckets lie within max weight / delta + 1 of the current one, so they are
+ * kept in a ring.
+ *
+ * delta = 1 behaves like Dial's algorithm (many small rounds); delta >= max
+ * weight behaves like Bellman-Ford (few large rounds, more re-relaxation).
+ * The default, max weight / average out-degree, is the usual middle ground.
+ *
+ * Usage: ./delta_stepping [graph.gr source] [--delta D] [--threads N]
+ *                         [--verify] [--print]
+ *        Without a file the graph is read from stdin like dijkstra.c.
+ * Compile with: gcc -O2 -pthread -o delta_stepping delta_stepping.c
+ */
+#define DIJKSTRA_NO_MAIN
+#define MAXV (1 << 25)
+#include "dijkstra.c"
+#include "csr_graph.h"
+
+#include <pthread.h>
+#include <time.h>
+#include <unistd.h>
+
+typedef struct {
+    int *items;
+    int size, capacity;
+} VertexList;
+
+static void vertexListPush(VertexList *list, int v) {
+    if (list->size == list->capacity) {
+        list->capacity = list->capacity ? 2 * list->capacity : 256;
+        list->items = (int *)realloc(list->items, list->capacity * sizeof(int));
+        if (list->items == NULL) {
+            fprintf(stderr, "Memory allocation failed.\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+    list->items[list->size++] = v;
+}
+
+// Lowers *addr to value if value is smaller; returns 1 if it did.
+static int atomicFetchMin(int *addr, int value) {
+    int old = __atomic_load_n(addr, __ATOMIC_RELAXED);
+    while (value < old) {
+        if (__atomic_compare_exchange_n(addr, &old, value, 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+            return 1;
+    }
+    return 0;
+}
+
+typedef struct {
+    VertexList improved;    // targets whose distance this thread lowered
+    VertexList settled;     // frontier vertices first seen in this bucket
+    long long relaxations;
+} DeltaWorker;
+
+typedef struct {
+    const CsrGraph *g;
+    int delta;
+    int *dist;
+    int threads;
+    pthread_barrier_t barrier;
+    DeltaWorker *workers;
+
+    // Round state, written by thread 0 between barriers.
+    VertexList frontier;
+    int heavy;              // 1: relax heavy edges of 'frontier'
+    int done;
+    int current;            // index of the bucket being settled
+    VertexList *ring;       // pending bucket b lives in ring[b % ringSize]
+    int ringSize;
+    int *frontierStamp;     // frontierStamp[v] == stamp: v already in this round
+    int stamp;
+    int *settledBucket;     // bucket in which v was last settled, -1 if never
+
+    long long buckets, lightRounds;
+} DeltaStepping;
+
+static void relaxSlice(DeltaStepping *ds, int t) {
+    const CsrGraph *g = ds->g;
+    DeltaWorker *me = &ds->workers[t];
+    int size = ds->frontier.size;
+    int begin = (int)((long long)size * t / ds->threads);
+    int end = (int)((long long)size * (t + 1) / ds->threads);
+    for (int i = begin; i < end; i++) {
+        int u = ds->frontier.items[i];
+        int du = __atomic_load_n(&ds->dist[u], __ATOMIC_RELAXED);
+        if (!ds->heavy && ds->settledBucket[u] != ds->current) {
+            ds->settledBucket[u] = ds->current;
+            vertexListPush(&me->settled, u);
+        }
+        for (int e = g->offset[u]; e < g->offset[u + 1]; e++) {
+            int w = g->weight[e];
+            if ((w > ds->delta) != ds->heavy)
+                continue;
+            me->relaxations++;
+            int v = g->target[e];
+            if (atomicFetchMin(&ds->dist[v], du + w))
+                vertexListPush(&me->improved, v);
+        }
+    }
+}
+
+// Thread 0, between rounds: files improved vertices and picks the next round.
+static void planNextRound(DeltaStepping *ds) {
+    ds->stamp++;
+    ds->frontier.size = 0;
+    for (int t = 0; t < ds->threads; t++) {
+        VertexList *improved = &ds->workers[t].improved;
+        for (int i = 0; i < improved->size; i++) {
+            int v = improved->items[i];
+            int b = ds->dist[v] / ds->delta;
+            if (b == ds->current) {
+                if (ds->frontierStamp[v] != ds->stamp) {
+                    ds->frontierStamp[v] = ds->stamp;
+                    vertexListPush(&ds->frontier, v);
+                }
+            } else {
+                vertexListPush(&ds->ring[b % ds->ringSize], v);
+            }
+        }
+        improved->size = 0;
+    }
+    if (!ds->heavy) {
+        if (ds->frontier.size > 0) {
+            ds->lightRounds++;
+            return;
+        }
+        // Bucket settled: relax heavy edges of everything settled in it.
+        ds->heavy = 1;
+        for (int t = 0; t < ds->threads; t++) {
+            VertexList *settled = &ds->workers[t].settled;
+            for (int i = 0; i < settled->size; i++)
+                vertexListPush(&ds->frontier, settled->items[i]);
+            settled->size = 0;
+        }
+        return;
+    }
+    // After the heavy round: move on to the next non-empty bucket, skipping
+    // entries whose distance has since dropped into an earlier bucket.
+    ds->heavy = 0;
+    for (int k = 1; k <= ds->ringSize; k++) {
+        int b = ds->current + k;
+        VertexList *slot = &ds->ring[b % ds->ringSize];
+        for (int i = 0; i < slot->size; i++) {
+            int v = slot->items[i];
+            if (ds->dist[v] / ds->delta == b && ds->frontierStamp[v] != ds->stamp) {
+                ds->frontierStamp[v] = ds->stamp;
+                vertexListPush(&ds->frontier, v);
+            }
+        }
+        slot->size = 0;
+        if (ds->frontier.size > 0) {
+            ds->current = b;
+            ds->buckets++;
+            ds->lightRounds++;
+            return;
+        }
+    }
+    ds->done = 1;
+}
+
+typedef struct {
+    DeltaStepping *ds;
+    int t;
+} DeltaThread;
+
+static void *deltaWorker(void *arg) {
+    DeltaThread *self = (DeltaThread *)arg;
+    DeltaStepping *ds = self->ds;
+    for (;;) {
+        pthread_barrier_wait(&ds->barrier);
+        if (ds->done)
+            break;
+        relaxSlice(ds, self->t);
+        pthread_barrier_wait(&ds->barrier);
+        if (self->t == 0)
+            planNextRound(ds);
+    }
+    return NULL;
+}
+
+/*
+ * Function: deltaStepping
+ * -----------------------
+ * Fills dist[0..V) with shortest distances from 'source' (INT_MAX =
+ * unreachable) using 'threads' threads and bucket width 'delta' (>= 1).
+ * All weights must be non-negative. Returns the total number of edge
+ * relaxations.
+ */
+long long deltaStepping(const CsrGraph *g, int source, int delta, int threads, int *dist) {
+    DeltaStepping ds;
+    memset(&ds, 0, sizeof(ds));
+    ds.g = g;
+    ds.delta = delta;
+    ds.dist = dist;
+    ds.threads = threads;
+    ds.workers = (DeltaWorker *)calloc(threads, sizeof(DeltaWorker));
+    ds.ringSize = g->maxWeight / delta + 2;
+    ds.ring = (VertexList *)calloc(ds.ringSize, sizeof(VertexList));
+    ds.frontierStamp = (int *)calloc(g->V, sizeof(int));
+    ds.settledBucket = (int *)malloc(g->V * sizeof(int));
+    if (ds.workers == NULL || ds.ring == NULL || ds.frontierStamp == NULL || ds.settledBucket == NULL) {
+        fprintf(stderr, "Memory allocation failed.\n");
+        exit(EXIT_FAILURE);
+    }
+    for (int v = 0; v < g->V; v++) {
+        dist[v] = INT_MAX;
+        ds.settledBucket[v] = -1;
+    }
+    dist[source] = 0;
+    vertexListPush(&ds.frontier, source);
+    ds.buckets = ds.lightRounds = 1;
+
+    pthread_barrier_init(&ds.barrier, NULL, threads);
+    DeltaThread *self = (DeltaThread *)malloc(threads * sizeof(DeltaThread));
+    pthread_t *ids = (pthread_t *)malloc(threads * sizeof(pthread_t));
+    for (int t = 0; t < threads; t++) {
+        self[t].ds = &ds;
+        self[t].t = t;
+        if (t > 0)
+            pthread_create(&ids[t], NULL, deltaWorker, &self[t]);
+    }
+    deltaWorker(&self[0]);
+    for (int t = 1; t < threads; t++)
+        pthread_join(ids[t], NULL);
+    pthread_barrier_destroy(&ds.barrier);
+
+    long long relaxations = 0;
+    for (int t = 0; t < threads; t++) {
+        relaxations += ds.workers[t].relaxations;
+        free(ds.workers[t].improved.items);
+        free(ds.workers[t].settled.items);
+    }
+    for (int i = 0; i < ds.ringSize; i++)
+        free(ds.ring[i].items);
+    free(ds.ring);
+    free(ds.frontier.items);
+    free(ds.frontierStamp);
+    free(ds.settledBucket);
+    free(ds.workers);
+    free(self);
+    free(ids);
+    return relaxations;
+}
+
+// max weight / average out-degree, at least 1.
+int defaultDelta(const CsrGraph *g) {
+    long long degree = g->V > 0 ? (long long)g->E / g->V : 0;
+    int delta = degree > 1 ? (int)(g->maxWeight / degree) : g->maxWeight;
+    return delta > 0 ? delta : 1;
+}
+
+#ifndef DELTA_STEPPING_NO_MAIN
+static double secondsSince(const struct timespec *start) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (now.tv_sec - start->tv_sec) + (now.tv_nsec - start->tv_nsec) * 1e-9;
+}
+
+int main(int argc, char *argv[]) {
+    int delta = 0;
+    int threads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    int verify = 0, print = 0;
+    const char *path = NULL;
+    int source = 0;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--delta") == 0 && i + 1 < argc)
+            delta = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc)
+            threads = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--verify") == 0)
+            verify = 1;
+        else if (strcmp(argv[i], "--print") == 0)
+            print = 1;
+        else if (path == NULL && i + 1 < argc) {
+            path = argv[i];
+            source = atoi(argv[++i]);
+        }
+    }
+    if (threads < 1)
+        threads = 1;
+
+    EdgeList list;
+    if (path != NULL) {
+        FILE *in = fopen(path, "r");
+        if (in == NULL) {
+            perror(path);
+            return 1;
+        }
+        if (readDimacsGraph(in, &list) != 0) {
+            fprintf(stderr, "%s: not a valid DIMACS shortest-path file.\n", path);
+            return 1;
+        }
+        fclose(in);
+        source--;   // DIMACS vertices are 1-based
+    } else {
+        int V, E;
+        printf("Enter the number of vertices: ");
+        if (scanf("%d", &V) != 1 || V < 0) {
+            fprintf(stderr, "Invalid number of vertices.\n");
+            return 1;
+        }
+        printf("Enter the number of edges: ");
+        if (scanf("%d", &E) != 1 || E < 0) {
+            fprintf(stderr, "Invalid number of edges.\n");
+            return 1;
+        }
+        initEdgeList(&list, V);
+        printf("Enter each edge in the format: src dest weight\n");
+        for (int i = 0; i < E; i++) {
+            int u, v, w;
+            if (scanf("%d %d %d", &u, &v, &w) != 3) {
+                fprintf(stderr, "Invalid edge.\n");
+                freeEdgeList(&list);
+                return 1;
+            }
+            if (addWeightedEdge(&list, u, v, w) != 0) {
+                fprintf(stderr, "Edge %d -> %d is out of range (vertices are 0..%d).\n", u, v, V - 1);
+                freeEdgeList(&list);
+                return 1;
+            }
+        }
+        printf("Enter the source vertex: ");
+        if (scanf("%d", &source) != 1)
+            source = -1;
+        print = 1;
+    }
+    if (source < 0 || source >= list.V) {
+        fprintf(stderr, "Source vertex out of range.\n");
+        freeEdgeList(&list);
+        return 1;
+    }
+
+    CsrGraph g;
+    buildCsrGraph(&g, &list);
+    if (g.negativeWeights) {
+        fprintf(stderr, "Delta-stepping needs non-negative edge weights.\n");
+        return 1;
+    }
+    if (delta < 1)
+        delta = defaultDelta(&g);
+
+    int *dist = (int *)malloc((g.V > 0 ? g.V : 1) * sizeof(int));
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    long long relaxations = deltaStepping(&g, source, delta, threads, dist);
+    double seconds = secondsSince(&start);
+
+    if (print)
+        printDistances(g.V, source, dist);
+    int reached = 0, farthest = 0;
+    for (int v = 0; v < g.V; v++) {
+        if (dist[v] != INT_MAX) {
+            reached++;
+            if (dist[v] > farthest)
+                farthest = dist[v];
+        }
+    }
+    printf("\nVertices reached : %d of %d (max distance %d)\n", reached, g.V, farthest);
+    printf("Delta            : %d\n", delta);
+    printf("Relaxations      : %lld (%.2f per edge)\n", relaxations,
+           g.E > 0 ? (double)relaxations / g.E : 0.0);
+    printf("Time             : %.3f s on %d threads\n", seconds, threads);
+
+    int status = 0;
+    if (verify) {
+        if (g.V > MAXV) {
+            fprintf(stderr, "Graph too large to verify (MAXV = %d).\n", MAXV);
+            return 1;
+        }
+        for (int v = 0; v < g.V; v++)
+            graph[v] = NULL;
+        for (int i = 0; i < list.E; i++)
+            addEdge(list.edges[i].u, list.edges[i].v, list.edges[i].w);
+        int *reference = (int *)malloc((g.V > 0 ? g.V : 1) * sizeof(int));
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        dijkstraDistances(g.V, source, selectQueue(), reference);
+        seconds = secondsSince(&start);
+        int same = memcmp(dist, reference, g.V * sizeof(int)) == 0;
+        printf("dijkstra()       : %.3f s, distances %s\n", seconds, same ? "identical" : "DIFFER");
+        status = same ? 0 : 1;
+        free(reference);
+    }
+
+    free(dist);
+    freeCsrGraph(&g);
+    freeEdgeList(&list);
+    return status;
+}
+#endif
@@ -1,7 +1,11 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <limits.h>
 
+#include "radix_heap.h"
+#include "dary_heap.h"
+
 // -------------------------- Adjacency List Structures --------------------------
 typedef struct AdjNode {
     int vertex;             // destination vertex
@@ -11,8 +15,13 @@ typedef struct AdjNode {
 
 // For simplicity, we will assume the maximum number of vertices is not huge
 // We'll store an adjacency list in a global array of pointers to AdjNodes
+// (programs that include this file for larger graphs define MAXV first)
+#ifndef MAXV
 #define MAXV 10000
+#endif
 AdjNode* graph[MAXV];   // graph[i] is head of adjacency list for vertex i
+int graphMaxWeight = 0;         // largest edge weight added so far
+int graphNegativeWeights = 0;   // set if any edge weight is < 0
 
 // -------------------------- Min-Heap (Priority Queue) Structures --------------------------
 typedef struct {
@@ -23,7 +32,7 @@ typedef struct {
 typedef struct {
     HeapNode* array;
     int size;      // number of elements currently in the heap
-    int capacity;  // total capacity of the heap array
+    int capacity;  // allocated length of the heap array; grows on demand
     // For quick decrease-key, we can keep an index-position map, but here we do a simpler approach.
 } MinHeap;
 
@@ -36,11 +45,22 @@ AdjNode* createNode(int v, int w) {
     return newNode;
 }
 
+// Adds edge (u -> v) at the head of u's list and tracks the weight range.
+void addEdge(int u, int v, int w) {
+    AdjNode* newNode = createNode(v, w);
+    newNode->next = graph[u];
+    graph[u] = newNode;
+    if(w > graphMaxWeight) graphMaxWeight = w;
+    if(w < 0) graphNegativeWeights = 1;
+}
+
 void buildGraph(int V, int E) {
     // Initialize adjacency lists
     for(int i = 0; i < V; i++) {
         graph[i] = NULL;
     }
+    graphMaxWeight = 0;
+    graphNegativeWeights = 0;
 
     printf("Enter each edge in the format: src dest weight\n");
     for(int i = 0; i < E; i++) {
@@ -48,9 +68,7 @@ void buildGraph(int V, int E) {
         scanf("%d %d %d", &u, &v, &w);
 
         // Create a new adjacency node for edge (u -> v)
-        AdjNode* newNode = createNode(v, w);
-        newNode->next = graph[u];
-        graph[u] = newNode;
+        addEdge(u, v, w);
     }
 }
 
@@ -108,11 +126,17 @@ void heapifyDown(MinHeap* minHeap, int idx) {
     }
 }
 
-// Insert a new (vertex, dist) into the min-heap
+// Insert a new (vertex, dist) into the min-heap.
+// With lazy insertion a vertex can be queued once per incoming edge, so the
+// heap holds up to E entries; the array doubles instead of dropping pushes.
 void pushMinHeap(MinHeap* minHeap, int vertex, int dist) {
     if(minHeap->size == minHeap->capacity) {
-        printf("Heap overflow!\n");
-        return;
+        minHeap->capacity = minHeap->capacity ? 2 * minHeap->capacity : 16;
+        minHeap->array = (HeapNode*)realloc(minHeap->array, minHeap->capacity * sizeof(HeapNode));
+        if(minHeap->array == NULL) {
+            fprintf(stderr, "Memory allocation failed.\n");
+            exit(EXIT_FAILURE);
+        }
     }
     // Insert at the end
     int idx = minHeap->size;
@@ -148,10 +172,102 @@ int isEmpty(MinHeap* minHeap) {
     return (minHeap->size == 0);
 }
 
-// Complexity: O(E log V) with a proper min-heap approach.
-void dijkstra(int V, int source) {
-    // dist[i] holds the shortest distance from 'source' to i
-    int* dist = (int*)malloc(V * sizeof(int));
+// -------------------------- Priority queue selection --------------------------
+// Dijkstra only needs a monotone queue when all weights are non-negative
+// integers: Dial's buckets when the largest weight is at most
+// DIAL_MAX_WEIGHT, the radix heap otherwise. Dijkstra is NOT correct with
+// negative weights: a settled vertex can still be improved later, so the
+// distances printed may be too large (use Bellman-Ford instead). main()
+// warns about it; the monotone queues would break outright, so the indexed
+// d-ary heap (decrease-key, at most V entries) is used for such graphs
+// only to keep the run well defined. The lazy binary heap is kept for
+// comparison.
+#define DIAL_MAX_WEIGHT 64
+
+typedef enum {
+    QUEUE_BINARY,
+    QUEUE_RADIX,
+    QUEUE_DIAL,
+    QUEUE_DARY
+} QueueKind;
+
+static const char *const queueNames[] = {"binary", "radix", "dial", "dary"};
+
+int heapArity = DARY_HEAP_ARITY;   // children per node of the d-ary heap
+
+typedef struct {
+    QueueKind kind;
+    MinHeap* binary;
+    RadixHeap radix;
+    DialQueue dial;
+    DaryHeap dary;
+} VertexQueue;
+
+QueueKind selectQueue(void) {
+    if(graphNegativeWeights) return QUEUE_DARY;
+    return graphMaxWeight <= DIAL_MAX_WEIGHT ? QUEUE_DIAL : QUEUE_RADIX;
+}
+
+static void initVertexQueue(VertexQueue* queue, QueueKind kind, int V) {
+    queue->kind = kind;
+    if(kind == QUEUE_BINARY) {
+        queue->binary = createMinHeap(V);
+    } else if(kind == QUEUE_RADIX) {
+        initRadixHeap(&queue->radix);
+    } else if(kind == QUEUE_DIAL) {
+        initDialQueue(&queue->dial, graphMaxWeight);
+    } else {
+        initDaryHeap(&queue->dary, V, heapArity);
+    }
+}
+
+static void queuePush(VertexQueue* queue, int vertex, int dist) {
+    switch(queue->kind) {
+    case QUEUE_BINARY: pushMinHeap(queue->binary, vertex, dist); break;
+    case QUEUE_RADIX:  radixHeapPush(&queue->radix, (unsigned int)dist, vertex); break;
+    case QUEUE_DIAL:   dialPush(&queue->dial, (unsigned int)dist, vertex); break;
+    case QUEUE_DARY:   daryHeapDecreaseKey(&queue->dary, vertex, dist); break;
+    }
+}
+
+// Pops the vertex with the smallest key; returns 0 when the queue is empty.
+static int queuePop(VertexQueue* queue, int* vertex) {
+    unsigned int key;
+    int dist;
+    switch(queue->kind) {
+    case QUEUE_BINARY:
+        if(isEmpty(queue->binary)) return 0;
+        *vertex = popMinHeap(queue->binary).vertex;
+        return 1;
+    case QUEUE_RADIX:
+        return radixHeapPop(&queue->radix, &key, vertex);
+    case QUEUE_DIAL:
+        return dialPop(&queue->dial, &key, vertex);
+    case QUEUE_DARY:
+        return daryHeapPop(&queue->dary, vertex, &dist);
+    }
+    return 0;
+}
+
+static void freeVertexQueue(VertexQueue* queue) {
+    if(queue->kind == QUEUE_BINARY) {
+        free(queue->binary->array);
+        free(queue->binary);
+    } else if(queue->kind == QUEUE_RADIX) {
+        freeRadixHeap(&queue->radix);
+    } else if(queue->kind == QUEUE_DIAL) {
+        freeDialQueue(&queue->dial);
+    } else {
+        freeDaryHeap(&queue->dary);
+    }
+}
+
+// Complexity: O(E log V) with the binary heap; O(E log_d V) with the d-ary
+// heap, where decrease-key replaces duplicate pushes; O(E + V log C) with
+// the radix heap and O(E + D) with Dial's buckets (C = max weight, D = max
+// distance).
+// Fills dist[0..V) with shortest distances from 'source' (INT_MAX = unreachable).
+void dijkstraDistances(int V, int source, QueueKind kind, int* dist) {
     // To keep track of which vertices are already "finalized"
     int* visited = (int*)calloc(V, sizeof(int));
 
@@ -161,16 +277,14 @@ void dijkstra(int V, int source) {
     }
     dist[source] = 0;
 
-    // Create a min-heap and insert (source, 0)
-    MinHeap* minHeap = createMinHeap(V);
-    pushMinHeap(minHeap, source, 0);
-
-    // While there are vertices in the min-heap
-    while(!isEmpty(minHeap)) {
-        // Extract the vertex with the smallest dist
-        HeapNode top = popMinHeap(minHeap);
-        int u = top.vertex;
+    // Create the priority queue and insert (source, 0)
+    VertexQueue queue;
+    initVertexQueue(&queue, kind, V);
+    queuePush(&queue, source, 0);
 
+    // While there are vertices in the queue
+    int u;
+    while(queuePop(&queue, &u)) {
         // If this vertex is already visited/finalized, skip
         if(visited[u]) continue;
         visited[u] = 1;
@@ -184,12 +298,17 @@ void dijkstra(int V, int source) {
             // If we can improve the distance to v, update and push
             if(!visited[v] && dist[u] != INT_MAX && dist[u] + w < dist[v]) {
                 dist[v] = dist[u] + w;
-                pushMinHeap(minHeap, v, dist[v]);
+                queuePush(&queue, v, dist[v]);
             }
             temp = temp->next;
         }
     }
 
+    free(visited);
+    freeVertexQueue(&queue);
+}
+
+void printDistances(int V, int source, const int* dist) {
     printf("\nShortest-path distances from source %d:\n", source);
     for(int i = 0; i < V; i++) {
         if(dist[i] == INT_MAX) {
@@ -198,16 +317,33 @@ void dijkstra(int V, int source) {
             printf("Vertex %d: %d\n", i, dist[i]);
         }
     }
+}
 
+void dijkstra(int V, int source, QueueKind kind) {
+    // dist[i] holds the shortest distance from 'source' to i
+    int* dist = (int*)malloc(V * sizeof(int));
+    dijkstraDistances(V, source, kind, dist);
+    printDistances(V, source, dist);
     free(dist);
-    free(visited);
-    free(minHeap->array);
-    free(minHeap);
 }
 
-int main() {
+#ifndef DIJKSTRA_NO_MAIN
+// Usage: ./dijkstra [binary|radix|dial|dary [d]]   (default: chosen from the weights)
+int main(int argc, char* argv[]) {
     int V, E;
     int source;
+    int forced = -1;
+
+    if(argc > 1) {
+        for(int k = 0; k < 4; k++) {
+            if(strcmp(argv[1], queueNames[k]) == 0) forced = k;
+        }
+        if(forced < 0) {
+            fprintf(stderr, "Unknown priority queue '%s' (binary, radix, dial or dary).\n", argv[1]);
+            return 1;
+        }
+        if(forced == QUEUE_DARY && argc > 2) heapArity = atoi(argv[2]);
+    }
 
     printf("Enter the number of vertices: ");
     scanf("%d", &V);
@@ -218,7 +354,21 @@ int main() {
 
     printf("Enter the source vertex: ");
     scanf("%d", &source);
-    dijkstra(V, source);
+
+    if(graphNegativeWeights) {
+        fprintf(stderr, "Warning: negative edge weights; Dijkstra's distances may be wrong.\n");
+    }
+    QueueKind kind = selectQueue();
+    if(forced >= 0) {
+        if(graphNegativeWeights && (forced == QUEUE_RADIX || forced == QUEUE_DIAL)) {
+            fprintf(stderr, "Negative weights: using the d-ary heap instead of %s.\n", queueNames[forced]);
+        } else {
+            kind = (QueueKind)forced;
+        }
+    }
+    printf("Priority queue: %s\n", queueNames[kind]);
+    dijkstra(V, source, kind);
 
     return 0;
-}
\ No newline at end of file
+}
+#endif
@@ -0,0 +1,407 @@
+/*
+ * Johnson's all-pairs shortest paths for sparse graphs with negative edges.
+ *
+ *   1. Add a vertex q with a 0-weight edge to every vertex and run
+ *      spfaDistances() (bellman_Ford.c) from q once: h(v) = dist(q, v).
+ *      A negative cycle anywhere in the graph shows up here.
+ *   2. Reweight: w'(u, v) = w(u, v) + h(u) - h(v) >= 0, by the triangle
+ *      inequality. Every s-t path changes by exactly h(s) - h(t), so
+ *      shortest paths are the same.
+ *   3. Run Dijkstra on w' from every source, in parallel: a pool of
+ *      threads takes sources from a shared counter, each with its own
+ *      heap and distance row, and writes d(s, t) = d'(s, t) - h(s) + h(t)
+ *      straight into the output matrix.
+ *
+ * Reweighting and undoing it are done in long long. A reweighted edge,
+ * reweighted path or distance that does not fit in an int (INT_MAX being
+ * the unreachable marker) makes the run fail instead of wrapping.
+ *
+ * The V x V matrix of int distances (INT_MAX = unreachable) is
+ * memory-mapped: with --out it is a file that the workers fill in place
+ * and the OS writes back, so V^2 values never have to fit in RAM at once.
+ * The layout is row-major by default. --tile B stores it as B x B tiles
+ * instead (the last row and column of tiles padded), so a block of
+ * sources x targets is one contiguous read, however large V is.
+ *
+ * File format: a 64-byte header (the magic "APSPMAT1", V, B with 0 for
+ * row-major), then the entries in native byte order.
+ *
+ * Usage: ./johnson [graph.gr] [--out matrix.bin] [--tile B] [--threads N]
+ *                  [--verify]
+ *        Without a file the graph is read from stdin like bellman_Ford.c
+ *        and the matrix is printed.
+ * Compile with: gcc -O2 -pthread -o johnson johnson.c
+ */
+#define BELLMAN_FORD_NO_MAIN
+#include "bellman_Ford.c"
+#include "csr_graph.h"
+#include "dary_heap.h"
+
+#include <pthread.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <time.h>
+#include <unistd.h>
+
+#define MATRIX_MAGIC "APSPMAT1"
+#define MATRIX_HEADER_SIZE 64
+
+typedef struct {
+    char magic[8];
+    int V;
+    int tile;               // 0 = row-major
+} MatrixHeader;
+
+typedef struct {
+    int V;
+    int tile;
+    int tilesPerRow;
+    int *data;
+    void *mapping;
+    size_t mappingSize;
+} DistanceMatrix;
+
+// Position of entry (s, t) in data[].
+static size_t matrixIndex(const DistanceMatrix *m, int s, int t) {
+    if (m->tile == 0)
+        return (size_t)s * m->V + t;
+    size_t B = (size_t)m->tile;
+    size_t tileIndex = (size_t)(s / m->tile) * m->tilesPerRow + t / m->tile;
+    return tileIndex * B * B + (size_t)(s % m->tile) * B + t % m->tile;
+}
+
+/*
+ * Function: openDistanceMatrix
+ * ----------------------------
+ * Maps a V x V matrix: a new file at 'path', or anonymous memory if 'path'
+ * is NULL. Returns 0 on success, -1 on error.
+ */
+int openDistanceMatrix(DistanceMatrix *m, int V, int tile, const char *path) {
+    m->V = V;
+    m->tile = tile;
+    m->tilesPerRow = tile > 0 ? (V + tile - 1) / tile : 0;
+    size_t side = tile > 0 ? (size_t)m->tilesPerRow * tile : (size_t)V;
+    m->mappingSize = MATRIX_HEADER_SIZE + side * side * sizeof(int);
+    if (path == NULL) {
+        m->mapping = mmap(NULL, m->mappingSize, PROT_READ | PROT_WRITE,
+                          MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    } else {
+        int fd = open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0 || ftruncate(fd, (off_t)m->mappingSize) != 0) {
+            perror(path);
+            if (fd >= 0)
+                close(fd);
+            return -1;
+        }
+        m->mapping = mmap(NULL, m->mappingSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        close(fd);
+    }
+    if (m->mapping == MAP_FAILED) {
+        perror("mmap");
+        return -1;
+    }
+    MatrixHeader *header = (MatrixHeader *)m->mapping;
+    memcpy(header->magic, MATRIX_MAGIC, 8);
+    header->V = V;
+    header->tile = tile;
+    m->data = (int *)((char *)m->mapping + MATRIX_HEADER_SIZE);
+    return 0;
+}
+
+void closeDistanceMatrix(DistanceMatrix *m) {
+    munmap(m->mapping, m->mappingSize);
+}
+
+// -------------------------- Per-source Dijkstra --------------------------
+typedef struct {
+    const CsrGraph *g;      // reweighted, all weights >= 0
+    const int *h;
+    DistanceMatrix *matrix;
+    int nextSource;         // work counter shared by the worker threads
+    int overflow;           // set if a length does not fit in an int
+} JohnsonPool;
+
+// d(s, t) from d'(s, t); flags the pool if it does not fit.
+static int unweightDistance(JohnsonPool *pool, int s, int t, int reweighted) {
+    if (reweighted == INT_MAX)
+        return INT_MAX;
+    long long d = (long long)reweighted - pool->h[s] + pool->h[t];
+    if (d <= INT_MIN || d >= INT_MAX) {
+        __atomic_store_n(&pool->overflow, 1, __ATOMIC_RELAXED);
+        return INT_MAX;
+    }
+    return (int)d;
+}
+
+static void *johnsonWorker(void *arg) {
+    JohnsonPool *pool = (JohnsonPool *)arg;
+    const CsrGraph *g = pool->g;
+    DistanceMatrix *m = pool->matrix;
+    int *dist = (int *)malloc((g->V > 0 ? g->V : 1) * sizeof(int));
+    if (dist == NULL) {
+        fprintf(stderr, "Memory allocation failed.\n");
+        exit(EXIT_FAILURE);
+    }
+    DaryHeap heap;
+    initDaryHeap(&heap, g->V, DARY_HEAP_ARITY);
+    for (;;) {
+        int s = __atomic_fetch_add(&pool->nextSource, 1, __ATOMIC_RELAXED);
+        if (s >= g->V)
+            break;
+        for (int v = 0; v < g->V; v++)
+            dist[v] = INT_MAX;
+        dist[s] = 0;
+        daryHeapDecreaseKey(&heap, s, 0);
+        int u, du;
+        while (daryHeapPop(&heap, &u, &du)) {
+            for (int e = g->offset[u]; e < g->offset[u + 1]; e++) {
+                int v = g->target[e];
+                long long candidate = (long long)du + g->weight[e];
+                if (candidate < dist[v]) {
+                    dist[v] = (int)candidate;
+                    daryHeapDecreaseKey(&heap, v, dist[v]);
+                } else if (dist[v] == INT_MAX) {
+                    __atomic_store_n(&pool->overflow, 1, __ATOMIC_RELAXED);
+                }
+            }
+        }
+        // Undo the reweighting while copying the row out.
+        if (m->tile == 0) {
+            int *row = &m->data[matrixIndex(m, s, 0)];
+            for (int t = 0; t < g->V; t++)
+                row[t] = unweightDistance(pool, s, t, dist[t]);
+        } else {
+            for (int t0 = 0; t0 < g->V; t0 += m->tile) {
+                int *run = &m->data[matrixIndex(m, s, t0)];
+                int end = t0 + m->tile < g->V ? t0 + m->tile : g->V;
+                for (int t = t0; t < end; t++)
+                    run[t - t0] = unweightDistance(pool, s, t, dist[t]);
+            }
+        }
+    }
+    freeDaryHeap(&heap);
+    free(dist);
+    return NULL;
+}
+
+/*
+ * Function: johnson
+ * -----------------
+ * Fills 'matrix' (opened for V vertices) with all shortest distances.
+ * Returns -1 on success, or a vertex on a negative cycle, in which case
+ * the matrix is left untouched and parent[] (V + 1 entries) describes the
+ * cycle for extractNegativeCycle(). Returns -2 if a reweighted edge or
+ * path, or a distance, does not fit in an int; the matrix is then
+ * incomplete.
+ */
+int johnson(int V, int E, const Edge edges[], int threads, DistanceMatrix *matrix, int *parent) {
+    // Step 1: potentials from a virtual source q = V.
+    Edge *augmented = (Edge *)malloc((E + V > 0 ? E + V : 1) * sizeof(Edge));
+    int *h = (int *)malloc((V + 1) * sizeof(int));
+    if (augmented == NULL || h == NULL) {
+        fprintf(stderr, "Memory allocation failed.\n");
+        exit(EXIT_FAILURE);
+    }
+    memcpy(augmented, edges, E * sizeof(Edge));
+    for (int v = 0; v < V; v++) {
+        augmented[E + v].u = V;
+        augmented[E + v].v = v;
+        augmented[E + v].weight = 0;
+    }
+    int cycleVertex = spfaDistances(V + 1, E + V, augmented, V, h, parent, NULL);
+    free(augmented);
+    if (cycleVertex >= 0) {
+        free(h);
+        return cycleVertex;
+    }
+
+    // Step 2: reweight.
+    EdgeList list;
+    initEdgeList(&list, V);
+    for (int j = 0; j < E; j++) {
+        long long w = (long long)edges[j].weight + h[edges[j].u] - h[edges[j].v];
+        if (w >= INT_MAX) {
+            freeEdgeList(&list);
+            free(h);
+            return -2;
+        }
+        addWeightedEdge(&list, edges[j].u, edges[j].v, (int)w);
+    }
+    CsrGraph g;
+    buildCsrGraph(&g, &list);
+    freeEdgeList(&list);
+
+    // Step 3: Dijkstra from every source.
+    JohnsonPool pool = {&g, h, matrix, 0, 0};
+    pthread_t *ids = (pthread_t *)malloc(threads * sizeof(pthread_t));
+    if (ids == NULL) {
+        fprintf(stderr, "Memory allocation failed.\n");
+        exit(EXIT_FAILURE);
+    }
+    int started = 0;
+    while (started < threads && pthread_create(&ids[started], NULL, johnsonWorker, &pool) == 0)
+        started++;
+    // Sources no thread could be started for are done here.
+    if (started < threads)
+        johnsonWorker(&pool);
+    for (int t = 0; t < started; t++)
+        pthread_join(ids[t], NULL);
+    free(ids);
+    freeCsrGraph(&g);
+    free(h);
+    return pool.overflow ? -2 : -1;
+}
+
+#ifndef JOHNSON_NO_MAIN
+static double secondsSince(const struct timespec *start) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (now.tv_sec - start->tv_sec) + (now.tv_nsec - start->tv_nsec) * 1e-9;
+}
+
+int main(int argc, char *argv[]) {
+    int threads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    int tile = 0, verify = 0;
+    const char *path = NULL, *outPath = NULL;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc)
+            threads = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--tile") == 0 && i + 1 < argc)
+            tile = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--out") == 0 && i + 1 < argc)
+            outPath = argv[++i];
+        else if (strcmp(argv[i], "--verify") == 0)
+            verify = 1;
+        else
+            path = argv[i];
+    }
+    if (threads < 1)
+        threads = 1;
+    if (tile < 0)
+        tile = 0;
+
+    int V, E;
+    Edge *edges;
+    if (path != NULL) {
+        FILE *in = fopen(path, "r");
+        if (in == NULL) {
+            perror(path);
+            return 1;
+        }
+        EdgeList list;
+        if (readDimacsGraph(in, &list) != 0) {
+            fprintf(stderr, "%s: not a valid DIMACS shortest-path file.\n", path);
+            return 1;
+        }
+        fclose(in);
+        V = list.V;
+        E = list.E;
+        edges = (Edge *)malloc((E > 0 ? E : 1) * sizeof(Edge));
+        if (edges == NULL) {
+            fprintf(stderr, "Memory allocation failed.\n");
+            return 1;
+        }
+        for (int i = 0; i < E; i++) {
+            edges[i].u = list.edges[i].u;
+            edges[i].v = list.edges[i].v;
+            edges[i].weight = list.edges[i].w;
+        }
+        freeEdgeList(&list);
+    } else {
+        printf("Enter the number of vertices: ");
+        if (scanf("%d", &V) != 1 || V < 0) {
+            fprintf(stderr, "Invalid number of vertices.\n");
+            return 1;
+        }
+        printf("Enter the number of edges: ");
+        if (scanf("%d", &E) != 1 || E < 0) {
+            fprintf(stderr, "Invalid number of edges.\n");
+            return 1;
+        }
+        edges = (Edge *)malloc((E > 0 ? E : 1) * sizeof(Edge));
+        if (edges == NULL) {
+            fprintf(stderr, "Memory allocation failed.\n");
+            return 1;
+        }
+        printf("Enter each edge in the format: u v weight\n");
+        for (int i = 0; i < E; i++) {
+            Edge *e = &edges[i];
+            if (scanf("%d %d %d", &e->u, &e->v, &e->weight) != 3 ||
+                e->u < 0 || e->u >= V || e->v < 0 || e->v >= V) {
+                fprintf(stderr, "Invalid edge (vertices are 0..%d).\n", V - 1);
+                free(edges);
+                return 1;
+            }
+        }
+    }
+    int base = path != NULL;    // DIMACS vertices are 1-based
+
+    DistanceMatrix matrix;
+    if (openDistanceMatrix(&matrix, V, tile, outPath) != 0)
+        return 1;
+    int *parent = (int *)malloc((V + 1) * sizeof(int));
+    if (parent == NULL) {
+        fprintf(stderr, "Memory allocation failed.\n");
+        return 1;
+    }
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    int cycleVertex = johnson(V, E, edges, threads, &matrix, parent);
+    double seconds = secondsSince(&start);
+
+    int status = 0;
+    if (cycleVertex >= 0) {
+        int *cycle = (int *)malloc((V + 1) * sizeof(int));
+        int length = extractNegativeCycle(V + 1, parent, cycleVertex, cycle);
+        printf("A negative-weight cycle exists in the graph:\n");
+        for (int i = 0; i < length; i++)
+            printf("%d -> ", cycle[i] + base);
+        printf("%d\n", cycle[0] + base);
+        free(cycle);
+        status = 1;
+    } else if (cycleVertex == -2) {
+        fprintf(stderr, "Distances do not fit in an int.\n");
+        status = 1;
+    } else {
+        if (path == NULL) {
+            printf("Shortest distances (row = source, column = target):\n");
+            for (int s = 0; s < V; s++) {
+                for (int t = 0; t < V; t++) {
+                    int d = matrix.data[matrixIndex(&matrix, s, t)];
+                    if (d == INT_MAX)
+                        printf("%6s", "INF");
+                    else
+                        printf("%6d", d);
+                }
+                printf("\n");
+            }
+        }
+        printf("\nAll pairs        : %d x %d, %s\n", V, V,
+               tile > 0 ? "tiled" : "row-major");
+        if (tile > 0)
+            printf("Tile             : %d x %d\n", tile, tile);
+        printf("Output           : %s\n", outPath != NULL ? outPath : "memory");
+        printf("Time             : %.3f s on %d threads\n", seconds, threads);
+    }
+
+    // Compares a sample of rows with spfaDistances() on the original weights.
+    if (verify && cycleVertex == -1 && V > 0) {
+        int *reference = (int *)malloc(V * sizeof(int));
+        int rows = V < 16 ? V : 16, wrong = 0;
+        for (int i = 0; i < rows; i++) {
+            int s = (int)((long long)i * V / rows);
+            spfaDistances(V, E, edges, s, reference, parent, NULL);
+            for (int t = 0; t < V; t++)
+                wrong += matrix.data[matrixIndex(&matrix, s, t)] != reference[t];
+        }
+        printf("spfaDistances()  : %d sampled rows, %s\n", rows, wrong ? "DIFFER" : "identical");
+        status = wrong ? 1 : 0;
+        free(reference);
+    }
+
+    closeDistanceMatrix(&matrix);
+    free(parent);
+    free(edges);
+    return status;
+}
+#endif
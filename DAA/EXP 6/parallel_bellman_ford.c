@@ -0,0 +1,398 @@
+/*
+ * Edge-parallel Bellman-Ford for dense graphs with negative weights.
+ *
+ * Layout: the edges are stored as three arrays (structure of arrays)
+ * src[], dst[] and weight[], sorted by source. A pass streams through
+ * them sequentially, and consecutive edges read the same dist[src], so
+ * the reads that are not sequential are the dist[dst] lookups.
+ *
+ * Kernel: with AVX2, eight edges are relaxed per step. dist[src] and
+ * dist[dst] are gathered, candidates dist[src] + weight are compared
+ * against dist[dst] in one instruction, and only the lanes that improve
+ * (few, after the first passes) are scattered one by one. Without AVX2
+ * the same loop runs a lane at a time.
+ *
+ * Threads: each thread owns an equal contiguous slice of the sorted
+ * edges, i.e. a range of sources. Two threads may lower the same
+ * dist[dst] at once, so the scatter is a compare-and-swap fetch-min: the
+ * smaller value always wins. Reading a slightly stale distance is
+ * harmless; it is a valid path length and the edge is seen again next
+ * pass. (Gathers are plain aligned 32-bit loads, which x86 never tears.)
+ * Threads meet at a barrier after each pass.
+ *
+ * Updates land in place, so a pass does at least as much as a textbook
+ * pass: the V - 1 pass bound and the early exit on a pass without change
+ * both still hold. Any change in pass V means a reachable negative cycle;
+ * its vertices are then recovered with spfaDistances().
+ *
+ * Usage: ./parallel_bellman_ford [graph.gr source] [--threads N] [--verify]
+ *                                [--print]
+ *        Without a file the graph is read from stdin like bellman_Ford.c.
+ * Compile with: gcc -O2 -mavx2 -pthread -o parallel_bellman_ford parallel_bellman_ford.c
+ */
+#define BELLMAN_FORD_NO_MAIN
+#include "bellman_Ford.c"
+#include "csr_graph.h"
+
+#include <pthread.h>
+#include <time.h>
+#include <unistd.h>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+typedef struct {
+    int V, E;
+    int *src;       // E entries, non-decreasing
+    int *dst;
+    int *weight;
+} EdgeArrays;
+
+// Counting sort of 'edges' by source into structure-of-arrays form.
+void buildEdgeArrays(EdgeArrays *ea, int V, int E, const Edge edges[]) {
+    ea->V = V;
+    ea->E = E;
+    ea->src = (int *)malloc((E > 0 ? E : 1) * sizeof(int));
+    ea->dst = (int *)malloc((E > 0 ? E : 1) * sizeof(int));
+    ea->weight = (int *)malloc((E > 0 ? E : 1) * sizeof(int));
+    int *next = (int *)calloc(V + 1, sizeof(int));
+    if (ea->src == NULL || ea->dst == NULL || ea->weight == NULL || next == NULL) {
+        fprintf(stderr, "Memory allocation failed.\n");
+        exit(EXIT_FAILURE);
+    }
+    for (int j = 0; j < E; j++)
+        next[edges[j].u + 1]++;
+    for (int u = 0; u < V; u++)
+        next[u + 1] += next[u];
+    for (int j = 0; j < E; j++) {
+        int slot = next[edges[j].u]++;
+        ea->src[slot] = edges[j].u;
+        ea->dst[slot] = edges[j].v;
+        ea->weight[slot] = edges[j].weight;
+    }
+    free(next);
+}
+
+void freeEdgeArrays(EdgeArrays *ea) {
+    free(ea->src);
+    free(ea->dst);
+    free(ea->weight);
+}
+
+// Lowers *addr to 'value' unless another thread already went lower.
+static int atomicFetchMin(int *addr, int value) {
+    int old = __atomic_load_n(addr, __ATOMIC_RELAXED);
+    while (value < old) {
+        if (__atomic_compare_exchange_n(addr, &old, value, 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+            return 1;
+    }
+    return 0;
+}
+
+// One relaxation of edges [begin, end). Returns 1 if a distance dropped.
+static int relaxEdgeRange(const EdgeArrays *ea, int *dist, int begin, int end) {
+    int changed = 0;
+    int j = begin;
+#if defined(__AVX2__)
+    const __m256i infinity = _mm256_set1_epi32(INT_MAX);
+    for (; j + 8 <= end; j += 8) {
+        __m256i src = _mm256_loadu_si256((const __m256i *)(ea->src + j));
+        __m256i dst = _mm256_loadu_si256((const __m256i *)(ea->dst + j));
+        __m256i weight = _mm256_loadu_si256((const __m256i *)(ea->weight + j));
+        __m256i du = _mm256_i32gather_epi32(dist, src, 4);
+        __m256i dv = _mm256_i32gather_epi32(dist, dst, 4);
+        __m256i candidate = _mm256_add_epi32(du, weight);
+        // Lanes with dist[src] = INF are masked out, whatever the sum wrapped to.
+        __m256i better = _mm256_andnot_si256(_mm256_cmpeq_epi32(du, infinity),
+                                             _mm256_cmpgt_epi32(dv, candidate));
+        unsigned int mask = (unsigned int)_mm256_movemask_ps(_mm256_castsi256_ps(better));
+        if (mask == 0)
+            continue;
+        int lanes[8];
+        _mm256_storeu_si256((__m256i *)lanes, candidate);
+        while (mask != 0) {
+            int lane = __builtin_ctz(mask);
+            changed |= atomicFetchMin(&dist[ea->dst[j + lane]], lanes[lane]);
+            mask &= mask - 1;
+        }
+    }
+#endif
+    for (; j < end; j++) {
+        int du = __atomic_load_n(&dist[ea->src[j]], __ATOMIC_RELAXED);
+        if (du != INT_MAX)
+            changed |= atomicFetchMin(&dist[ea->dst[j]], du + ea->weight[j]);
+    }
+    return changed;
+}
+
+typedef struct {
+    const EdgeArrays *ea;
+    int *dist;
+    int threads;
+    int *changed;           // per thread, for the current pass
+    int passes;
+    int done;
+    int negativeCycle;
+    pthread_mutex_t startLock;  // held until every worker has been created
+    pthread_barrier_t barrier;
+} ParallelBellmanFord;
+
+typedef struct {
+    ParallelBellmanFord *pb;
+    int t;
+} BellmanFordThread;
+
+static void *bellmanFordWorker(void *arg) {
+    BellmanFordThread *self = (BellmanFordThread *)arg;
+    ParallelBellmanFord *pb = self->pb;
+    const EdgeArrays *ea = pb->ea;
+    // pb->threads and the barrier are final once startLock is released.
+    pthread_mutex_lock(&pb->startLock);
+    pthread_mutex_unlock(&pb->startLock);
+    // Equal slices, cut on multiples of 8 so only the last has a scalar tail.
+    long long share = ((long long)ea->E + pb->threads - 1) / pb->threads;
+    share = (share + 7) / 8 * 8;
+    int begin = (int)(share * self->t < ea->E ? share * self->t : ea->E);
+    int end = (int)(share * (self->t + 1) < ea->E ? share * (self->t + 1) : ea->E);
+    while (!pb->done) {
+        pb->changed[self->t] = relaxEdgeRange(ea, pb->dist, begin, end);
+        pthread_barrier_wait(&pb->barrier);
+        if (self->t == 0) {
+            int any = 0;
+            for (int t = 0; t < pb->threads; t++)
+                any |= pb->changed[t];
+            pb->passes++;
+            // Passes 1 .. V-1 find every shortest path; a change in pass V
+            // can only come from a negative cycle.
+            pb->negativeCycle = any && pb->passes >= ea->V;
+            pb->done = !any || pb->passes >= ea->V;
+        }
+        pthread_barrier_wait(&pb->barrier);
+    }
+    return NULL;
+}
+
+/*
+ * Function: parallelBellmanFord
+ * -----------------------------
+ * Fills dist[0..V) with shortest distances from 'source' (INT_MAX =
+ * unreachable) using 'threads' threads. Returns 1 if a negative cycle is
+ * reachable from the source (dist[] is then meaningless), 0 otherwise.
+ * The number of passes made goes to *passes if it is not NULL.
+ */
+int parallelBellmanFord(const EdgeArrays *ea, int source, int threads, int *dist, int *passes) {
+    ParallelBellmanFord pb;
+    pb.ea = ea;
+    pb.dist = dist;
+    pb.threads = threads;
+    pb.changed = (int *)calloc(threads, sizeof(int));
+    BellmanFordThread *self = (BellmanFordThread *)malloc(threads * sizeof(BellmanFordThread));
+    pthread_t *ids = (pthread_t *)malloc(threads * sizeof(pthread_t));
+    if (pb.changed == NULL || self == NULL || ids == NULL) {
+        fprintf(stderr, "Memory allocation failed.\n");
+        exit(EXIT_FAILURE);
+    }
+    pb.passes = 0;
+    pb.done = 0;
+    pb.negativeCycle = 0;
+    for (int v = 0; v < ea->V; v++)
+        dist[v] = INT_MAX;
+    dist[source] = 0;
+
+    // If a thread cannot be created, the ones that were share the edges.
+    pthread_mutex_init(&pb.startLock, NULL);
+    pthread_mutex_lock(&pb.startLock);
+    int started = 1;
+    for (int t = 0; t < threads; t++) {
+        self[t].pb = &pb;
+        self[t].t = t;
+        if (t > 0) {
+            if (pthread_create(&ids[t], NULL, bellmanFordWorker, &self[t]) != 0)
+                break;
+            started++;
+        }
+    }
+    pb.threads = started;
+    pthread_barrier_init(&pb.barrier, NULL, started);
+    pthread_mutex_unlock(&pb.startLock);
+    bellmanFordWorker(&self[0]);
+    for (int t = 1; t < started; t++)
+        pthread_join(ids[t], NULL);
+    pthread_barrier_destroy(&pb.barrier);
+    pthread_mutex_destroy(&pb.startLock);
+
+    if (passes != NULL)
+        *passes = pb.passes;
+    free(pb.changed);
+    free(self);
+    free(ids);
+    return pb.negativeCycle;
+}
+
+#ifndef PARALLEL_BELLMAN_FORD_NO_MAIN
+static double secondsSince(const struct timespec *start) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (now.tv_sec - start->tv_sec) + (now.tv_nsec - start->tv_nsec) * 1e-9;
+}
+
+int main(int argc, char *argv[]) {
+    int threads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    int verify = 0, print = 0;
+    const char *path = NULL;
+    int source = 0;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc)
+            threads = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--verify") == 0)
+            verify = 1;
+        else if (strcmp(argv[i], "--print") == 0)
+            print = 1;
+        else if (path == NULL && i + 1 < argc) {
+            path = argv[i];
+            source = atoi(argv[++i]);
+        }
+    }
+    if (threads < 1)
+        threads = 1;
+
+    int V, E;
+    Edge *edges;
+    if (path != NULL) {
+        FILE *in = fopen(path, "r");
+        if (in == NULL) {
+            perror(path);
+            return 1;
+        }
+        EdgeList list;
+        if (readDimacsGraph(in, &list) != 0) {
+            fprintf(stderr, "%s: not a valid DIMACS shortest-path file.\n", path);
+            return 1;
+        }
+        fclose(in);
+        V = list.V;
+        E = list.E;
+        edges = (Edge *)malloc((E > 0 ? E : 1) * sizeof(Edge));
+        if (edges == NULL) {
+            fprintf(stderr, "Memory allocation failed.\n");
+            return 1;
+        }
+        for (int i = 0; i < E; i++) {
+            edges[i].u = list.edges[i].u;
+            edges[i].v = list.edges[i].v;
+            edges[i].weight = list.edges[i].w;
+        }
+        freeEdgeList(&list);
+        source--;   // DIMACS vertices are 1-based
+    } else {
+        printf("Enter the number of vertices: ");
+        if (scanf("%d", &V) != 1 || V < 0) {
+            fprintf(stderr, "Invalid number of vertices.\n");
+            return 1;
+        }
+        printf("Enter the number of edges: ");
+        if (scanf("%d", &E) != 1 || E < 0) {
+            fprintf(stderr, "Invalid number of edges.\n");
+            return 1;
+        }
+        edges = (Edge *)malloc((E > 0 ? E : 1) * sizeof(Edge));
+        if (edges == NULL) {
+            fprintf(stderr, "Memory allocation failed.\n");
+            return 1;
+        }
+        printf("Enter each edge in the format: u v weight\n");
+        for (int i = 0; i < E; i++) {
+            Edge *e = &edges[i];
+            if (scanf("%d %d %d", &e->u, &e->v, &e->weight) != 3 ||
+                e->u < 0 || e->u >= V || e->v < 0 || e->v >= V) {
+                fprintf(stderr, "Invalid edge (vertices are 0..%d).\n", V - 1);
+                free(edges);
+                return 1;
+            }
+        }
+        printf("Enter the source vertex index: ");
+        if (scanf("%d", &source) != 1)
+            source = -1;
+        print = 1;
+    }
+    if (source < 0 || source >= V) {
+        fprintf(stderr, "Source vertex out of range.\n");
+        return 1;
+    }
+
+    EdgeArrays ea;
+    buildEdgeArrays(&ea, V, E, edges);
+    int *dist = (int *)malloc(V * sizeof(int));
+    int *parent = (int *)malloc(V * sizeof(int));
+    if (dist == NULL || parent == NULL) {
+        fprintf(stderr, "Memory allocation failed.\n");
+        return 1;
+    }
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    int passes;
+    int negativeCycle = parallelBellmanFord(&ea, source, threads, dist, &passes);
+    double seconds = secondsSince(&start);
+
+    int status = 0;
+    if (negativeCycle) {
+        int cycleVertex = spfaDistances(V, E, edges, source, dist, parent, NULL);
+        int *cycle = (int *)malloc(V * sizeof(int));
+        if (cycleVertex < 0 || cycle == NULL) {
+            fprintf(stderr, "spfaDistances() found no negative cycle.\n");
+            return 1;
+        }
+        int length = extractNegativeCycle(V, parent, cycleVertex, cycle);
+        printf("A negative-weight cycle exists in the graph reachable from the source:\n");
+        for (int i = 0; i < length; i++)
+            printf("%d -> ", cycle[i] + (path != NULL));
+        printf("%d\n", cycle[0] + (path != NULL));
+        free(cycle);
+    } else if (print) {
+        // Vertices are numbered as in the input: 1-based for DIMACS files.
+        printf("Shortest distances from vertex %d:\n", source + (path != NULL));
+        for (int i = 0; i < V; i++) {
+            if (dist[i] == INT_MAX)
+                printf("Vertex %d: INF\n", i + (path != NULL));
+            else
+                printf("Vertex %d: %d\n", i + (path != NULL), dist[i]);
+        }
+    }
+    int reached = 0;
+    for (int v = 0; v < V; v++)
+        reached += dist[v] != INT_MAX;
+    printf("\nVertices reached : %d of %d\n", reached, V);
+    printf("Passes           : %d (edges examined: %lld)\n", passes, (long long)passes * E);
+    printf("Time             : %.3f s on %d threads%s\n", seconds, threads,
+#if defined(__AVX2__)
+           " (AVX2)"
+#else
+           ""
+#endif
+    );
+
+    if (verify && !negativeCycle) {
+        int *reference = (int *)malloc(V * sizeof(int));
+        if (reference == NULL) {
+            fprintf(stderr, "Memory allocation failed.\n");
+            return 1;
+        }
+        long long relaxations;
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        int cycle = bellmanFordDistances(V, E, edges, source, reference, parent, &relaxations);
+        seconds = secondsSince(&start);
+        int same = cycle < 0 && memcmp(dist, reference, V * sizeof(int)) == 0;
+        printf("bellmanFordDistances(): %.3f s, distances %s\n", seconds,
+               same ? "identical" : "DIFFER");
+        status = same ? 0 : 1;
+        free(reference);
+    }
+
+    free(dist);
+    free(parent);
+    free(edges);
+    freeEdgeArrays(&ea);
+    return status;
+}
+#endif
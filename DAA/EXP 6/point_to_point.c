@@ -0,0 +1,523 @@
+/*
+ * Point-to-point shortest paths: one source, one target, stop early.
+ *
+ *   dijkstra  Plain Dijkstra that stops when the target is settled.
+ *   bidir     Bidirectional Dijkstra: a forward search from s on the graph
+ *             and a backward search from t on the reverse graph, always
+ *             advancing the side whose queue minimum is smaller. mu is the
+ *             best s-t distance seen through an edge joining the two
+ *             searches; once minF + minB >= mu no shorter path can exist
+ *             and mu is the answer. Each side settles roughly a ball of
+ *             half the radius.
+ *   astar     A* with a pluggable heuristic h(v) <= dist(v, t): the queue
+ *             key is dist(s, v) + h(v), which pulls the search towards t.
+ *             Two heuristics are provided:
+ *               coordinates  scaled straight-line distance; the scale is
+ *                            the smallest weight / length ratio over all
+ *                            edges, so h never overestimates.
+ *               ALT          landmarks with precomputed distances to and
+ *                            from every vertex; the triangle inequality
+ *                            gives dist(L, t) - dist(L, v) <= dist(v, t) and
+ *                            dist(v, L) - dist(t, L) <= dist(v, t).
+ *
+ * Every query returns the distance and the path. Per-query state is reset
+ * through a stamp per vertex, so a query costs only what it touches, not
+ * O(V).
+ *
+ * Usage: ./point_to_point [graph.gr] [--co coords.co] [--landmarks K]
+ *                         [--algo dijkstra|bidir|astar|alt|all]
+ *        With a file, queries are read from stdin as 1-based "s t" pairs.
+ *        Without one, the graph and a single query are read like dijkstra.c.
+ * Compile with: gcc -O2 -o point_to_point point_to_point.c -lm
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <math.h>
+
+#include "csr_graph.h"
+#include "dary_heap.h"
+
+// h(v) for a fixed target; must never exceed dist(v, target).
+typedef int (*Heuristic)(int v, int target, const void *ctx);
+
+typedef struct {
+    int distance;       // INT_MAX if the target is unreachable
+    int *path;          // path[0] = s ... path[length - 1] = t (malloc'd)
+    int length;
+    long long settled;  // vertices taken off the queue(s)
+} PathResult;
+
+// One search direction: tentative distances, parents and the queue.
+typedef struct {
+    int *dist;
+    int *parent;
+    int *stamp;         // dist/parent of v are valid iff stamp[v] == query
+    DaryHeap heap;
+} SearchSide;
+
+typedef struct {
+    int V;
+    int query;
+    SearchSide forward, backward;
+} QueryWorkspace;
+
+static void initSide(SearchSide *side, int V) {
+    side->dist = (int *)malloc((V > 0 ? V : 1) * sizeof(int));
+    side->parent = (int *)malloc((V > 0 ? V : 1) * sizeof(int));
+    side->stamp = (int *)calloc(V > 0 ? V : 1, sizeof(int));
+    if (side->dist == NULL || side->parent == NULL || side->stamp == NULL) {
+        fprintf(stderr, "Memory allocation failed.\n");
+        exit(EXIT_FAILURE);
+    }
+    initDaryHeap(&side->heap, V, DARY_HEAP_ARITY);
+}
+
+static void freeSide(SearchSide *side) {
+    free(side->dist);
+    free(side->parent);
+    free(side->stamp);
+    freeDaryHeap(&side->heap);
+}
+
+void initQueryWorkspace(QueryWorkspace *ws, int V) {
+    ws->V = V;
+    ws->query = 0;
+    initSide(&ws->forward, V);
+    initSide(&ws->backward, V);
+}
+
+void freeQueryWorkspace(QueryWorkspace *ws) {
+    freeSide(&ws->forward);
+    freeSide(&ws->backward);
+}
+
+static int sideDist(const SearchSide *side, int query, int v) {
+    return side->stamp[v] == query ? side->dist[v] : INT_MAX;
+}
+
+static void sideSet(SearchSide *side, int query, int v, int dist, int parent) {
+    side->stamp[v] = query;
+    side->dist[v] = dist;
+    side->parent[v] = parent;
+}
+
+// Starts a query: new stamp, empty queues.
+static void beginQuery(QueryWorkspace *ws) {
+    ws->query++;
+    clearDaryHeap(&ws->forward.heap);
+    clearDaryHeap(&ws->backward.heap);
+}
+
+// Builds s..t from forward parents up to 'meet', then backward parents
+// (which point towards t) from 'meet' on.
+static void buildPath(const QueryWorkspace *ws, int meet, int useBackward, PathResult *result) {
+    int head = 0, tail = 0;
+    for (int v = meet; v != -1; v = ws->forward.parent[v])
+        head++;
+    if (useBackward) {
+        for (int v = ws->backward.parent[meet]; v != -1; v = ws->backward.parent[v])
+            tail++;
+    }
+    result->path = (int *)malloc((head + tail) * sizeof(int));
+    if (result->path == NULL) {
+        fprintf(stderr, "Memory allocation failed.\n");
+        exit(EXIT_FAILURE);
+    }
+    int i = head;
+    for (int v = meet; v != -1; v = ws->forward.parent[v])
+        result->path[--i] = v;
+    i = head;
+    if (useBackward) {
+        for (int v = ws->backward.parent[meet]; v != -1; v = ws->backward.parent[v])
+            result->path[i++] = v;
+    }
+    result->length = head + tail;
+}
+
+static int zeroHeuristic(int v, int target, const void *ctx) {
+    (void)v;
+    (void)target;
+    (void)ctx;
+    return 0;
+}
+
+/*
+ * Function: aStarSearch
+ * ---------------------
+ * A* from s to t. With an admissible h the first time t leaves the queue
+ * its distance is final. A vertex whose distance improves after it was
+ * expanded is queued again, so h need not be consistent. With h = 0 this
+ * is Dijkstra with early exit.
+ */
+int aStarSearch(const CsrGraph *g, QueryWorkspace *ws, int s, int t, Heuristic h, const void *ctx,
+                PathResult *result) {
+    SearchSide *fw = &ws->forward;
+    beginQuery(ws);
+    result->distance = INT_MAX;
+    result->path = NULL;
+    result->length = 0;
+    result->settled = 0;
+
+    sideSet(fw, ws->query, s, 0, -1);
+    daryHeapDecreaseKey(&fw->heap, s, h(s, t, ctx));
+    int u, key;
+    while (daryHeapPop(&fw->heap, &u, &key)) {
+        result->settled++;
+        if (u == t) {
+            result->distance = fw->dist[t];
+            buildPath(ws, t, 0, result);
+            return result->distance;
+        }
+        int du = fw->dist[u];
+        for (int e = g->offset[u]; e < g->offset[u + 1]; e++) {
+            int v = g->target[e];
+            int nd = du + g->weight[e];
+            if (nd < sideDist(fw, ws->query, v)) {
+                int hv = h(v, t, ctx);
+                if (hv == INT_MAX)
+                    continue;   // the heuristic proved t unreachable from v
+                sideSet(fw, ws->query, v, nd, u);
+                daryHeapDecreaseKey(&fw->heap, v, nd + hv);
+            }
+        }
+    }
+    return INT_MAX;
+}
+
+int dijkstraPointToPoint(const CsrGraph *g, QueryWorkspace *ws, int s, int t, PathResult *result) {
+    return aStarSearch(g, ws, s, t, zeroHeuristic, NULL, result);
+}
+
+/*
+ * Function: bidirectionalDijkstra
+ * -------------------------------
+ * 'reverse' must be the transpose of 'g' (buildReverseCsrGraph()).
+ */
+int bidirectionalDijkstra(const CsrGraph *g, const CsrGraph *reverse, QueryWorkspace *ws, int s,
+                          int t, PathResult *result) {
+    SearchSide *fw = &ws->forward, *bw = &ws->backward;
+    beginQuery(ws);
+    int q = ws->query;
+    result->path = NULL;
+    result->length = 0;
+    result->settled = 0;
+
+    sideSet(fw, q, s, 0, -1);
+    sideSet(bw, q, t, 0, -1);
+    daryHeapDecreaseKey(&fw->heap, s, 0);
+    daryHeapDecreaseKey(&bw->heap, t, 0);
+    int mu = s == t ? 0 : INT_MAX;
+    int meet = s == t ? s : -1;
+
+    while (fw->heap.size > 0 && bw->heap.size > 0) {
+        int minF = fw->heap.nodes[0].key, minB = bw->heap.nodes[0].key;
+        if (mu != INT_MAX && (long long)minF + minB >= mu)
+            break;
+        int forward = minF <= minB;
+        SearchSide *side = forward ? fw : bw, *other = forward ? bw : fw;
+        const CsrGraph *graph = forward ? g : reverse;
+        int u, du;
+        daryHeapPop(&side->heap, &u, &du);
+        result->settled++;
+        for (int e = graph->offset[u]; e < graph->offset[u + 1]; e++) {
+            int v = graph->target[e];
+            int nd = du + graph->weight[e];
+            if (nd < sideDist(side, q, v)) {
+                sideSet(side, q, v, nd, u);
+                daryHeapDecreaseKey(&side->heap, v, nd);
+            }
+            int dv = sideDist(other, q, v);
+            if (dv != INT_MAX && nd + dv < mu) {
+                mu = nd + dv;
+                meet = v;
+            }
+        }
+    }
+    result->distance = mu;
+    if (meet >= 0)
+        buildPath(ws, meet, 1, result);
+    return mu;
+}
+
+// -------------------------- Heuristics --------------------------
+typedef struct {
+    const double *x, *y;
+    double scale;       // min over edges of weight / straight-line length
+} CoordinateHeuristic;
+
+void initCoordinateHeuristic(CoordinateHeuristic *ch, const CsrGraph *g, const double *x,
+                             const double *y) {
+    ch->x = x;
+    ch->y = y;
+    ch->scale = -1;
+    for (int u = 0; u < g->V; u++) {
+        for (int e = g->offset[u]; e < g->offset[u + 1]; e++) {
+            int v = g->target[e];
+            double length = hypot(x[u] - x[v], y[u] - y[v]);
+            if (length > 0 && (ch->scale < 0 || g->weight[e] / length < ch->scale))
+                ch->scale = g->weight[e] / length;
+        }
+    }
+    if (ch->scale < 0)
+        ch->scale = 0;
+}
+
+int coordinateHeuristic(int v, int target, const void *ctx) {
+    const CoordinateHeuristic *ch = (const CoordinateHeuristic *)ctx;
+    return (int)floor(ch->scale * hypot(ch->x[v] - ch->x[target], ch->y[v] - ch->y[target]));
+}
+
+typedef struct {
+    int count;
+    int V;
+    int *from;          // from[l * V + v] = dist(L_l, v)
+    int *to;            // to[l * V + v]   = dist(v, L_l)
+} LandmarkHeuristic;
+
+// Full single-source Dijkstra on a CSR graph, for landmark tables.
+static void csrDistances(const CsrGraph *g, int source, int *dist) {
+    DaryHeap heap;
+    initDaryHeap(&heap, g->V, DARY_HEAP_ARITY);
+    for (int v = 0; v < g->V; v++)
+        dist[v] = INT_MAX;
+    dist[source] = 0;
+    daryHeapDecreaseKey(&heap, source, 0);
+    int u, du;
+    while (daryHeapPop(&heap, &u, &du)) {
+        for (int e = g->offset[u]; e < g->offset[u + 1]; e++) {
+            int v = g->target[e];
+            if (du + g->weight[e] < dist[v]) {
+                dist[v] = du + g->weight[e];
+                daryHeapDecreaseKey(&heap, v, dist[v]);
+            }
+        }
+    }
+    freeDaryHeap(&heap);
+}
+
+/*
+ * Picks 'count' landmarks by farthest selection: each new landmark is the
+ * reachable vertex whose distance to the nearest chosen landmark is
+ * largest, which spreads them towards the edges of the graph where they
+ * give the tightest bounds.
+ */
+void initLandmarkHeuristic(LandmarkHeuristic *lh, const CsrGraph *g, const CsrGraph *reverse,
+                           int count) {
+    int V = g->V;
+    lh->count = count;
+    lh->V = V;
+    lh->from = (int *)malloc((size_t)count * V * sizeof(int));
+    lh->to = (int *)malloc((size_t)count * V * sizeof(int));
+    int *nearest = (int *)malloc(V * sizeof(int));
+    if (lh->from == NULL || lh->to == NULL || nearest == NULL) {
+        fprintf(stderr, "Memory allocation failed.\n");
+        exit(EXIT_FAILURE);
+    }
+    for (int v = 0; v < V; v++)
+        nearest[v] = INT_MAX;
+    int landmark = 0;
+    for (int l = 0; l < count; l++) {
+        csrDistances(g, landmark, &lh->from[(size_t)l * V]);
+        csrDistances(reverse, landmark, &lh->to[(size_t)l * V]);
+        int best = -1;
+        for (int v = 0; v < V; v++) {
+            int d = lh->from[(size_t)l * V + v];
+            if (d < nearest[v])
+                nearest[v] = d;
+            if (nearest[v] != INT_MAX && (best < 0 || nearest[v] > nearest[best]))
+                best = v;
+        }
+        landmark = best >= 0 ? best : 0;
+    }
+    free(nearest);
+}
+
+void freeLandmarkHeuristic(LandmarkHeuristic *lh) {
+    free(lh->from);
+    free(lh->to);
+}
+
+int landmarkHeuristic(int v, int target, const void *ctx) {
+    const LandmarkHeuristic *lh = (const LandmarkHeuristic *)ctx;
+    int best = 0;
+    for (int l = 0; l < lh->count; l++) {
+        const int *from = &lh->from[(size_t)l * lh->V];
+        const int *to = &lh->to[(size_t)l * lh->V];
+        // L reaches v but not t: then v cannot reach t either.
+        if (from[v] != INT_MAX && from[target] == INT_MAX)
+            return INT_MAX;
+        if (from[v] != INT_MAX && from[target] - from[v] > best)
+            best = from[target] - from[v];
+        if (to[v] != INT_MAX && to[target] != INT_MAX && to[v] - to[target] > best)
+            best = to[v] - to[target];
+    }
+    return best;
+}
+
+#ifndef POINT_TO_POINT_NO_MAIN
+static void printPath(const char *algo, int s, int t, const PathResult *r, int base) {
+    if (r->distance == INT_MAX) {
+        printf("%-8s %d -> %d: unreachable (%lld settled)\n", algo, s + base, t + base, r->settled);
+        return;
+    }
+    printf("%-8s %d -> %d: distance %d, %d vertices on path, %lld settled\n", algo, s + base,
+           t + base, r->distance, r->length, r->settled);
+}
+
+int main(int argc, char *argv[]) {
+    const char *graphPath = NULL, *coordPath = NULL, *algo = "all";
+    int landmarks = 8;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--co") == 0 && i + 1 < argc)
+            coordPath = argv[++i];
+        else if (strcmp(argv[i], "--landmarks") == 0 && i + 1 < argc)
+            landmarks = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--algo") == 0 && i + 1 < argc)
+            algo = argv[++i];
+        else
+            graphPath = argv[i];
+    }
+
+    EdgeList list;
+    int base = 0;   // vertex numbering shown to the user
+    if (graphPath != NULL) {
+        FILE *in = fopen(graphPath, "r");
+        if (in == NULL) {
+            perror(graphPath);
+            return 1;
+        }
+        if (readDimacsGraph(in, &list) != 0) {
+            fprintf(stderr, "%s: not a valid DIMACS shortest-path file.\n", graphPath);
+            return 1;
+        }
+        fclose(in);
+        base = 1;
+    } else {
+        int V, E;
+        printf("Enter the number of vertices: ");
+        if (scanf("%d", &V) != 1 || V < 0) {
+            fprintf(stderr, "Invalid number of vertices.\n");
+            return 1;
+        }
+        printf("Enter the number of edges: ");
+        if (scanf("%d", &E) != 1 || E < 0) {
+            fprintf(stderr, "Invalid number of edges.\n");
+            return 1;
+        }
+        initEdgeList(&list, V);
+        printf("Enter each edge in the format: src dest weight\n");
+        for (int i = 0; i < E; i++) {
+            int u, v, w;
+            if (scanf("%d %d %d", &u, &v, &w) != 3) {
+                fprintf(stderr, "Invalid edge.\n");
+                freeEdgeList(&list);
+                return 1;
+            }
+            if (addWeightedEdge(&list, u, v, w) != 0) {
+                fprintf(stderr, "Edge %d -> %d is out of range (vertices are 0..%d).\n", u, v, V - 1);
+                freeEdgeList(&list);
+                return 1;
+            }
+        }
+    }
+
+    CsrGraph g, reverse;
+    buildCsrGraph(&g, &list);
+    buildReverseCsrGraph(&reverse, &list);
+    freeEdgeList(&list);
+    if (g.negativeWeights) {
+        fprintf(stderr, "Point-to-point search needs non-negative edge weights.\n");
+        return 1;
+    }
+
+    int all = strcmp(algo, "all") == 0;
+    double *x = NULL, *y = NULL;
+    CoordinateHeuristic coords;
+    if (coordPath != NULL) {
+        FILE *in = fopen(coordPath, "r");
+        x = (double *)calloc(g.V, sizeof(double));
+        y = (double *)calloc(g.V, sizeof(double));
+        if (in == NULL || readDimacsCoordinates(in, g.V, x, y) != g.V) {
+            fprintf(stderr, "%s: missing or incomplete coordinates.\n", coordPath);
+            return 1;
+        }
+        fclose(in);
+        initCoordinateHeuristic(&coords, &g, x, y);
+    } else if (strcmp(algo, "astar") == 0) {
+        fprintf(stderr, "--algo astar needs --co <coordinates file>.\n");
+        return 1;
+    }
+    LandmarkHeuristic alt;
+    int useAlt = (all || strcmp(algo, "alt") == 0) && landmarks > 0 && g.V > 0;
+    if (useAlt)
+        initLandmarkHeuristic(&alt, &g, &reverse, landmarks);
+
+    QueryWorkspace ws;
+    initQueryWorkspace(&ws, g.V);
+    int s, t, status = 0;
+    if (graphPath == NULL) {
+        printf("Enter the source vertex: ");
+        if (scanf("%d", &s) != 1)
+            s = -1;
+        printf("Enter the target vertex: ");
+        if (scanf("%d", &t) != 1)
+            t = -1;
+    }
+    while ((graphPath == NULL) || scanf("%d %d", &s, &t) == 2) {
+        s -= base;
+        t -= base;
+        if (s < 0 || s >= g.V || t < 0 || t >= g.V) {
+            fprintf(stderr, "Vertex out of range.\n");
+            status = 1;
+        } else {
+            PathResult results[4];
+            const char *names[4];
+            int n = 0;
+            if (all || strcmp(algo, "dijkstra") == 0) {
+                dijkstraPointToPoint(&g, &ws, s, t, &results[n]);
+                names[n++] = "dijkstra";
+            }
+            if (all || strcmp(algo, "bidir") == 0) {
+                bidirectionalDijkstra(&g, &reverse, &ws, s, t, &results[n]);
+                names[n++] = "bidir";
+            }
+            if (x != NULL && (all || strcmp(algo, "astar") == 0)) {
+                aStarSearch(&g, &ws, s, t, coordinateHeuristic, &coords, &results[n]);
+                names[n++] = "astar";
+            }
+            if (useAlt) {
+                aStarSearch(&g, &ws, s, t, landmarkHeuristic, &alt, &results[n]);
+                names[n++] = "alt";
+            }
+            for (int i = 0; i < n; i++) {
+                printPath(names[i], s, t, &results[i], base);
+                if (results[i].distance != results[0].distance) {
+                    fprintf(stderr, "%s disagrees with %s.\n", names[i], names[0]);
+                    status = 1;
+                }
+            }
+            if (n > 0 && results[0].distance != INT_MAX) {
+                printf("Path:");
+                for (int i = 0; i < results[0].length; i++)
+                    printf(" %d", results[0].path[i] + base);
+                printf("\n");
+            }
+            for (int i = 0; i < n; i++)
+                free(results[i].path);
+        }
+        if (graphPath == NULL)
+            break;
+    }
+
+    freeQueryWorkspace(&ws);
+    if (useAlt)
+        freeLandmarkHeuristic(&alt);
+    free(x);
+    free(y);
+    freeCsrGraph(&g);
+    freeCsrGraph(&reverse);
+    return status;
+}
+#endif
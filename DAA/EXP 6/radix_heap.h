@@ -0,0 +1,164 @@
+#ifndef RADIX_HEAP_H
+#define RADIX_HEAP_H
+
+/*
+ * Monotone integer priority queues for Dijkstra.
+ *
+ * Dijkstra with non-negative weights only ever inserts keys >= the last key
+ * extracted, so it does not need a general heap:
+ *
+ *   RadixHeap  - 33 buckets for 32-bit keys. Bucket 0 holds keys equal to
+ *                'last' (the last extracted key); bucket i > 0 holds keys
+ *                whose highest bit differing from 'last' is bit i - 1.
+ *                When bucket 0 is empty, the first non-empty bucket is
+ *                emptied into lower buckets around its minimum. A key only
+ *                ever moves to lower buckets, so each key is moved at most
+ *                32 times: amortised O(log C) per operation, in practice
+ *                close to O(1), with sequential access only.
+ *
+ *   DialQueue  - Dial's algorithm: C + 1 buckets in a ring, for maximum
+ *                edge weight C. Every queued key lies in [cursor, cursor + C],
+ *                so key % (C + 1) identifies its bucket and all keys in a
+ *                bucket are equal. O(1) push, pop advances the cursor over
+ *                empty buckets. Best when C is small.
+ *
+ * Both grow their buckets on demand; there is no fixed capacity.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+typedef struct {
+    unsigned int key;
+    int vertex;
+} QueueEntry;
+
+// Growable array of entries, used as a bucket by both queues.
+typedef struct {
+    QueueEntry *items;
+    int size, capacity;
+} EntryBucket;
+
+static void bucketPush(EntryBucket *bucket, unsigned int key, int vertex) {
+    if (bucket->size == bucket->capacity) {
+        bucket->capacity = bucket->capacity ? 2 * bucket->capacity : 16;
+        bucket->items = (QueueEntry *)realloc(bucket->items, bucket->capacity * sizeof(QueueEntry));
+        if (bucket->items == NULL) {
+            fprintf(stderr, "Memory allocation failed.\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+    bucket->items[bucket->size].key = key;
+    bucket->items[bucket->size].vertex = vertex;
+    bucket->size++;
+}
+
+// -------------------------- Radix heap --------------------------
+#define RADIX_BUCKETS 33
+
+typedef struct {
+    EntryBucket buckets[RADIX_BUCKETS];
+    unsigned int last;      // last extracted key; every queued key is >= last
+    int size;
+} RadixHeap;
+
+static int radixBucketIndex(unsigned int last, unsigned int key) {
+    return key == last ? 0 : 32 - __builtin_clz(key ^ last);
+}
+
+void initRadixHeap(RadixHeap *heap) {
+    for (int i = 0; i < RADIX_BUCKETS; i++) {
+        heap->buckets[i].items = NULL;
+        heap->buckets[i].size = heap->buckets[i].capacity = 0;
+    }
+    heap->last = 0;
+    heap->size = 0;
+}
+
+// 'key' must be >= the last key popped.
+void radixHeapPush(RadixHeap *heap, unsigned int key, int vertex) {
+    bucketPush(&heap->buckets[radixBucketIndex(heap->last, key)], key, vertex);
+    heap->size++;
+}
+
+// Pops an entry with the smallest key. Returns 0 if the heap is empty.
+int radixHeapPop(RadixHeap *heap, unsigned int *key, int *vertex) {
+    if (heap->size == 0)
+        return 0;
+    if (heap->buckets[0].size == 0) {
+        int i = 1;
+        while (heap->buckets[i].size == 0)
+            i++;
+        EntryBucket *bucket = &heap->buckets[i];
+        unsigned int newLast = bucket->items[0].key;
+        for (int j = 1; j < bucket->size; j++) {
+            if (bucket->items[j].key < newLast)
+                newLast = bucket->items[j].key;
+        }
+        // Every key in bucket i agrees with newLast above bit i - 1, so
+        // each one lands in a bucket below i.
+        heap->last = newLast;
+        for (int j = 0; j < bucket->size; j++) {
+            QueueEntry e = bucket->items[j];
+            bucketPush(&heap->buckets[radixBucketIndex(newLast, e.key)], e.key, e.vertex);
+        }
+        bucket->size = 0;
+    }
+    EntryBucket *zero = &heap->buckets[0];
+    zero->size--;
+    *key = zero->items[zero->size].key;
+    *vertex = zero->items[zero->size].vertex;
+    heap->size--;
+    return 1;
+}
+
+void freeRadixHeap(RadixHeap *heap) {
+    for (int i = 0; i < RADIX_BUCKETS; i++)
+        free(heap->buckets[i].items);
+}
+
+// -------------------------- Dial's buckets --------------------------
+typedef struct {
+    EntryBucket *buckets;
+    int count;              // C + 1
+    int cursor;             // bucket of the smallest key that may still be queued
+    int size;
+} DialQueue;
+
+void initDialQueue(DialQueue *queue, int maxWeight) {
+    queue->count = maxWeight + 1;
+    queue->buckets = (EntryBucket *)calloc(queue->count, sizeof(EntryBucket));
+    if (queue->buckets == NULL) {
+        fprintf(stderr, "Memory allocation failed.\n");
+        exit(EXIT_FAILURE);
+    }
+    queue->cursor = 0;
+    queue->size = 0;
+}
+
+// 'key' must lie in [last key popped, last key popped + maxWeight].
+void dialPush(DialQueue *queue, unsigned int key, int vertex) {
+    bucketPush(&queue->buckets[key % (unsigned int)queue->count], key, vertex);
+    queue->size++;
+}
+
+int dialPop(DialQueue *queue, unsigned int *key, int *vertex) {
+    if (queue->size == 0)
+        return 0;
+    while (queue->buckets[queue->cursor].size == 0)
+        queue->cursor = (queue->cursor + 1 == queue->count) ? 0 : queue->cursor + 1;
+    EntryBucket *bucket = &queue->buckets[queue->cursor];
+    bucket->size--;
+    *key = bucket->items[bucket->size].key;
+    *vertex = bucket->items[bucket->size].vertex;
+    queue->size--;
+    return 1;
+}
+
+void freeDialQueue(DialQueue *queue) {
+    for (int i = 0; i < queue->count; i++)
+        free(queue->buckets[i].items);
+    free(queue->buckets);
+}
+
+#endif
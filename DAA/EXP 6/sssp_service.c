@@ -0,0 +1,416 @@
+/*
+ * Batch single-source shortest paths over one shared graph.
+ *
+ * dijkstra.c builds its adjacency lists from stdin for every run and
+ * answers one source. This program loads the graph once into a CSR
+ * (csr_graph.h) that the worker threads share read-only, then answers
+ * batches of sources for as long as input keeps coming.
+ *
+ * The threads stay alive between batches and meet at a barrier to start
+ * and finish each one; inside a batch they take sources from a shared
+ * counter. Each thread owns a reusable arena:
+ *   dist[V]      all INT_MAX between queries
+ *   heap         indexed d-ary heap (dary_heap.h), empty between queries
+ *   reached      the vertices the current query settled
+ * After a query only the reached entries of dist[] are reset, so a query
+ * costs what it touches and nothing is allocated per query. Arenas are
+ * padded to a cache line so threads do not false-share their heap sizes.
+ *
+ * For every source the result is a summary: vertices reached, the
+ * farthest distance and the sum of distances. --print also lists every
+ * distance; those rows go to a count x V buffer that the caller passes
+ * with the batch and reuses across batches. Throughput is reported per
+ * batch and overall, in queries per second.
+ *
+ * Usage: ./sssp_service [graph.gr] [--threads N] [--print]
+ *                       [--random COUNT [--batch SIZE]]
+ *        Each input line is one batch of 1-based sources. --random runs
+ *        COUNT random sources instead, SIZE (default 64) per batch.
+ *        Without a file the graph is read from stdin like dijkstra.c and
+ *        batches use 0-based vertices.
+ * Compile with: gcc -O2 -pthread -o sssp_service sssp_service.c
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <pthread.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "csr_graph.h"
+#include "dary_heap.h"
+
+typedef struct {
+    int source;
+    int reached;
+    int farthest;
+    long long total;        // sum of the finite distances
+    int *dist;              // this source's row of the batch's distance buffer, or NULL
+} SsspResult;
+
+// One per thread, each on its own cache line(s).
+typedef struct {
+    _Alignas(CACHE_LINE) int *dist;
+    int *reached;
+    DaryHeap heap;
+} SsspArena;
+
+struct SsspService;
+
+typedef struct {
+    struct SsspService *service;
+    int t;
+} SsspThread;
+
+typedef struct SsspService {
+    const CsrGraph *g;
+    int threads;
+    SsspArena *arenas;
+    SsspThread *self;
+    pthread_t *ids;
+    pthread_barrier_t barrier;
+    // The current batch, published by ssspBatch() before the start barrier.
+    const int *sources;
+    SsspResult *results;
+    int *distances;         // count x V, or NULL
+    int count;
+    int next;               // work counter shared by the worker threads
+    int shutdown;
+} SsspService;
+
+// Dijkstra from 'source' in the arena; leaves dist[] all INT_MAX again.
+// 'row' (V entries, may be NULL) receives all distances.
+static void runQuery(const CsrGraph *g, SsspArena *arena, int source, int *row,
+                     SsspResult *result) {
+    int *dist = arena->dist;
+    int reached = 0;
+    dist[source] = 0;
+    daryHeapDecreaseKey(&arena->heap, source, 0);
+    int u, du;
+    while (daryHeapPop(&arena->heap, &u, &du)) {
+        arena->reached[reached++] = u;
+        for (int e = g->offset[u]; e < g->offset[u + 1]; e++) {
+            int v = g->target[e];
+            if (du + g->weight[e] < dist[v]) {
+                dist[v] = du + g->weight[e];
+                daryHeapDecreaseKey(&arena->heap, v, dist[v]);
+            }
+        }
+    }
+
+    result->source = source;
+    result->reached = reached;
+    result->farthest = 0;
+    result->total = 0;
+    result->dist = row;
+    for (int i = 0; i < reached; i++) {
+        int d = dist[arena->reached[i]];
+        result->total += d;
+        if (d > result->farthest)
+            result->farthest = d;
+    }
+    if (row != NULL)
+        memcpy(row, dist, g->V * sizeof(int));
+    for (int i = 0; i < reached; i++)
+        dist[arena->reached[i]] = INT_MAX;
+}
+
+// Answers the published batch until the shared counter runs out.
+static void drainBatch(SsspService *service, int t) {
+    for (;;) {
+        int i = __atomic_fetch_add(&service->next, 1, __ATOMIC_RELAXED);
+        if (i >= service->count)
+            break;
+        int *row = service->distances != NULL
+                       ? service->distances + (size_t)i * service->g->V : NULL;
+        runQuery(service->g, &service->arenas[t], service->sources[i], row,
+                 &service->results[i]);
+    }
+}
+
+static void *ssspWorker(void *arg) {
+    SsspThread *self = (SsspThread *)arg;
+    SsspService *service = self->service;
+    for (;;) {
+        pthread_barrier_wait(&service->barrier);
+        if (service->shutdown)
+            break;
+        drainBatch(service, self->t);
+        pthread_barrier_wait(&service->barrier);
+    }
+    return NULL;
+}
+
+/*
+ * Function: initSsspService
+ * -------------------------
+ * Starts threads - 1 workers over 'g', which must stay unchanged (and have
+ * non-negative weights) until freeSsspService(). The calling thread is
+ * the remaining worker inside ssspBatch().
+ */
+void initSsspService(SsspService *service, const CsrGraph *g, int threads) {
+    memset(service, 0, sizeof(*service));
+    service->g = g;
+    service->threads = threads;
+    service->arenas = (SsspArena *)aligned_alloc(CACHE_LINE, threads * sizeof(SsspArena));
+    service->self = (SsspThread *)malloc(threads * sizeof(SsspThread));
+    service->ids = (pthread_t *)malloc(threads * sizeof(pthread_t));
+    if (service->arenas == NULL || service->self == NULL || service->ids == NULL) {
+        fprintf(stderr, "Memory allocation failed.\n");
+        exit(EXIT_FAILURE);
+    }
+    for (int t = 0; t < threads; t++) {
+        SsspArena *arena = &service->arenas[t];
+        arena->dist = (int *)malloc((g->V > 0 ? g->V : 1) * sizeof(int));
+        arena->reached = (int *)malloc((g->V > 0 ? g->V : 1) * sizeof(int));
+        if (arena->dist == NULL || arena->reached == NULL) {
+            fprintf(stderr, "Memory allocation failed.\n");
+            exit(EXIT_FAILURE);
+        }
+        for (int v = 0; v < g->V; v++)
+            arena->dist[v] = INT_MAX;
+        initDaryHeap(&arena->heap, g->V, DARY_HEAP_ARITY);
+    }
+    pthread_barrier_init(&service->barrier, NULL, threads);
+    for (int t = 1; t < threads; t++) {
+        service->self[t].service = service;
+        service->self[t].t = t;
+        pthread_create(&service->ids[t], NULL, ssspWorker, &service->self[t]);
+    }
+}
+
+/*
+ * Function: ssspBatch
+ * -------------------
+ * Runs one query per source (0-based, all in range) and fills results[i]
+ * for sources[i]. If 'distances' is not NULL it must hold count x V ints;
+ * row i receives every distance from sources[i] and results[i].dist
+ * points to it. Returns when the whole batch is done.
+ */
+void ssspBatch(SsspService *service, const int *sources, int count, SsspResult *results,
+               int *distances) {
+    service->sources = sources;
+    service->results = results;
+    service->distances = distances;
+    service->count = count;
+    service->next = 0;
+    pthread_barrier_wait(&service->barrier);
+    drainBatch(service, 0);
+    pthread_barrier_wait(&service->barrier);
+}
+
+void freeSsspService(SsspService *service) {
+    service->shutdown = 1;
+    pthread_barrier_wait(&service->barrier);
+    for (int t = 1; t < service->threads; t++)
+        pthread_join(service->ids[t], NULL);
+    pthread_barrier_destroy(&service->barrier);
+    for (int t = 0; t < service->threads; t++) {
+        free(service->arenas[t].dist);
+        free(service->arenas[t].reached);
+        freeDaryHeap(&service->arenas[t].heap);
+    }
+    free(service->arenas);
+    free(service->self);
+    free(service->ids);
+}
+
+#ifndef SSSP_SERVICE_NO_MAIN
+static double secondsSince(const struct timespec *start) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (now.tv_sec - start->tv_sec) + (now.tv_nsec - start->tv_nsec) * 1e-9;
+}
+
+// Parses one line of sources into 'batch' (grown as needed). Returns the
+// count, or -1 if a vertex is malformed or out of range.
+static int parseBatch(char *line, int base, int V, int **batch, int *capacity) {
+    int count = 0;
+    char *cursor = line, *end;
+    for (;;) {
+        long s = strtol(cursor, &end, 10);
+        if (end == cursor)
+            break;
+        cursor = end;
+        s -= base;
+        if (s < 0 || s >= V)
+            return -1;
+        if (count == *capacity) {
+            *capacity = *capacity ? 2 * *capacity : 64;
+            *batch = (int *)realloc(*batch, *capacity * sizeof(int));
+            if (*batch == NULL) {
+                fprintf(stderr, "Memory allocation failed.\n");
+                exit(EXIT_FAILURE);
+            }
+        }
+        (*batch)[count++] = (int)s;
+    }
+    while (*cursor == ' ' || *cursor == '\t' || *cursor == '\r' || *cursor == '\n')
+        cursor++;
+    return *cursor == '\0' ? count : -1;
+}
+
+int main(int argc, char *argv[]) {
+    int threads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    int print = 0, randomCount = 0, batchSize = 64;
+    const char *path = NULL;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc)
+            threads = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--print") == 0)
+            print = 1;
+        else if (strcmp(argv[i], "--random") == 0 && i + 1 < argc)
+            randomCount = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--batch") == 0 && i + 1 < argc)
+            batchSize = atoi(argv[++i]);
+        else
+            path = argv[i];
+    }
+    if (threads < 1)
+        threads = 1;
+    if (batchSize < 1)
+        batchSize = 1;
+
+    EdgeList list;
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    if (path != NULL) {
+        FILE *in = fopen(path, "r");
+        if (in == NULL) {
+            perror(path);
+            return 1;
+        }
+        if (readDimacsGraph(in, &list) != 0) {
+            fprintf(stderr, "%s: not a valid DIMACS shortest-path file.\n", path);
+            return 1;
+        }
+        fclose(in);
+    } else {
+        int V, E;
+        printf("Enter the number of vertices: ");
+        if (scanf("%d", &V) != 1 || V < 0) {
+            fprintf(stderr, "Invalid number of vertices.\n");
+            return 1;
+        }
+        printf("Enter the number of edges: ");
+        if (scanf("%d", &E) != 1 || E < 0) {
+            fprintf(stderr, "Invalid number of edges.\n");
+            return 1;
+        }
+        initEdgeList(&list, V);
+        printf("Enter each edge in the format: src dest weight\n");
+        for (int i = 0; i < E; i++) {
+            int u, v, w;
+            if (scanf("%d %d %d", &u, &v, &w) != 3) {
+                fprintf(stderr, "Invalid edge.\n");
+                freeEdgeList(&list);
+                return 1;
+            }
+            if (addWeightedEdge(&list, u, v, w) != 0) {
+                fprintf(stderr, "Edge %d -> %d is out of range (vertices are 0..%d).\n", u, v, V - 1);
+                freeEdgeList(&list);
+                return 1;
+            }
+        }
+        scanf("%*[^\n]");   // rest of the last edge line
+        printf("Enter batches of source vertices, one batch per line:\n");
+    }
+    int base = path != NULL;    // DIMACS vertices are 1-based
+    CsrGraph g;
+    buildCsrGraph(&g, &list);
+    freeEdgeList(&list);
+    if (g.negativeWeights) {
+        fprintf(stderr, "Dijkstra needs non-negative edge weights.\n");
+        return 1;
+    }
+    if (path != NULL)
+        fprintf(stderr, "Loaded %d vertices, %d edges in %.3f s\n", g.V, g.E, secondsSince(&start));
+
+    SsspService service;
+    initSsspService(&service, &g, threads);
+    int *batch = NULL, capacity = 0, batches = 0, status = 0;
+    long long queries = 0;
+    double seconds = 0;
+    SsspResult *results = NULL;
+    int *distances = NULL;      // --print: count x V, grown with the batch size
+    int resultCapacity = 0;
+    char *line = NULL;
+    size_t lineSize = 0;
+    unsigned int seed = 12345;
+    for (;;) {
+        int count;
+        if (randomCount > 0) {
+            if (queries >= randomCount || g.V == 0)
+                break;
+            count = randomCount - queries < batchSize ? (int)(randomCount - queries) : batchSize;
+            if (count > capacity) {
+                capacity = count;
+                batch = (int *)realloc(batch, capacity * sizeof(int));
+                if (batch == NULL) {
+                    fprintf(stderr, "Memory allocation failed.\n");
+                    return 1;
+                }
+            }
+            for (int i = 0; i < count; i++)
+                batch[i] = (int)(rand_r(&seed) % (unsigned int)g.V);
+        } else {
+            if (getline(&line, &lineSize, stdin) < 0)
+                break;
+            count = parseBatch(line, base, g.V, &batch, &capacity);
+            if (count < 0) {
+                fprintf(stderr, "Skipping batch with an invalid vertex: %s", line);
+                status = 1;
+                continue;
+            }
+            if (count == 0)
+                continue;
+        }
+        if (count > resultCapacity) {
+            resultCapacity = count;
+            results = (SsspResult *)realloc(results, resultCapacity * sizeof(SsspResult));
+            if (print)
+                distances = (int *)realloc(distances,
+                                           (size_t)resultCapacity * (g.V > 0 ? g.V : 1) * sizeof(int));
+            if (results == NULL || (print && distances == NULL)) {
+                fprintf(stderr, "Memory allocation failed.\n");
+                return 1;
+            }
+        }
+
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        ssspBatch(&service, batch, count, results, distances);
+        double batchSeconds = secondsSince(&start);
+        seconds += batchSeconds;
+        queries += count;
+        batches++;
+
+        for (int i = 0; i < count; i++) {
+            const SsspResult *r = &results[i];
+            printf("Source %d: reached %d of %d, farthest %d, total %lld\n", r->source + base,
+                   r->reached, g.V, r->farthest, r->total);
+            if (r->dist != NULL) {
+                for (int v = 0; v < g.V; v++) {
+                    if (r->dist[v] == INT_MAX)
+                        printf("  Vertex %d: INF\n", v + base);
+                    else
+                        printf("  Vertex %d: %d\n", v + base, r->dist[v]);
+                }
+            }
+        }
+        fprintf(stderr, "Batch %d: %d sources in %.3f s (%.0f queries/s)\n", batches, count,
+                batchSeconds, batchSeconds > 0 ? count / batchSeconds : 0.0);
+    }
+    if (queries > 0)
+        fprintf(stderr, "Total: %lld queries in %d batches, %.3f s, %.0f queries/s on %d threads\n",
+                queries, batches, seconds, seconds > 0 ? queries / seconds : 0.0, threads);
+
+    freeSsspService(&service);
+    free(batch);
+    free(results);
+    free(distances);
+    free(line);
+    freeCsrGraph(&g);
+    return status;
+}
+#endif
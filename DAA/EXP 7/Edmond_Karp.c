@@ -2,7 +2,14 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include "flow_stats.h"
+#include "dimacs_flow.h"
+
+#ifndef MAX
 #define MAX 100  // Maximum number of vertices
+#endif
+
+FlowStats ekStats;  // counters for the most recent edmondKarp() call
 
 int bfs(int n, int s, int t, int residual[MAX][MAX], int parent[MAX]) {
     int visited[MAX];
@@ -17,6 +24,7 @@ int bfs(int n, int s, int t, int residual[MAX][MAX], int parent[MAX]) {
 
     while (front < rear) {
         int u = queue[front++];
+        ekStats.edgesScanned += n;
         for (int v = 0; v < n; v++) {
             // If there's available capacity and v is not visited
             if (!visited[v] && residual[u][v] > 0) {
@@ -34,11 +42,15 @@ int bfs(int n, int s, int t, int residual[MAX][MAX], int parent[MAX]) {
 }
 
 int edmondKarp(int n, int s, int t, int capacity[MAX][MAX]) {
-    int flow[MAX][MAX];       // flow[u][v]
-    int residual[MAX][MAX];   // residual[u][v]
+    // static: with -DMAX=... these grow to MAX^2 ints, too big for the stack
+    static int flow[MAX][MAX];       // flow[u][v]
+    static int residual[MAX][MAX];   // residual[u][v]
     int parent[MAX];          // to store path found by BFS
     int maxFlow = 0;
 
+    memset(&ekStats, 0, sizeof(ekStats));
+    clock_t phase = clock();
+
     // Initialize flow and residual
     memset(flow, 0, sizeof(flow));
     for (int u = 0; u < n; u++) {
@@ -46,11 +58,23 @@ int edmondKarp(int n, int s, int t, int capacity[MAX][MAX]) {
             residual[u][v] = capacity[u][v]; 
         }
     }
+    ekStats.initTime = elapsedSeconds(phase);
 
+#if TRACE
     int iteration = 1;
+#endif
 
     // While we can find a path from s to t in the residual graph
-    while (bfs(n, s, t, residual, parent)) {
+    while (1) {
+        phase = clock();
+        int found = bfs(n, s, t, residual, parent);
+        ekStats.searchTime += elapsedSeconds(phase);
+        if (!found) {
+            break;
+        }
+        phase = clock();
+        ekStats.augmentations++;
+
         // Find the bottleneck capacity along this path
         int path_flow = 1e9;  // a large number
         int v = t;
@@ -62,6 +86,7 @@ int edmondKarp(int n, int s, int t, int capacity[MAX][MAX]) {
             v = u;
         }
 
+#if TRACE
         // Print the augmenting path found
         printf("\nIteration %d:\n", iteration++);
         printf("Augmenting path (sink -> source): ");
@@ -72,6 +97,7 @@ int edmondKarp(int n, int s, int t, int capacity[MAX][MAX]) {
         }
         printf("%d\n", s);
         printf("Bottleneck capacity = %d\n", path_flow);
+#endif
 
         // Update flows and residual capacities along this path
         v = t;
@@ -83,12 +109,14 @@ int edmondKarp(int n, int s, int t, int capacity[MAX][MAX]) {
             residual[u][v] -= path_flow;
             // Add path_flow to reverse edge capacity
             residual[v][u] += path_flow;
+            ekStats.residualUpdates += 2;
 
             v = u;
         }
 
         maxFlow += path_flow;
 
+#if TRACE
         // Print how the flow was augmented on this path
         printf("Updated flow on edges in the path:\n");
         v = t;
@@ -98,7 +126,10 @@ int edmondKarp(int n, int s, int t, int capacity[MAX][MAX]) {
                    u, v, flow[u][v], capacity[u][v]);
             v = u;
         }
+#endif
+        ekStats.augmentTime += elapsedSeconds(phase);
     }
+#if FLOW_REPORT
     printf("\nNo more augmenting paths. Maximum Flow = %d\n", maxFlow);
 
     // Optionally, print final flow on all edges with capacity > 0
@@ -111,13 +142,62 @@ int edmondKarp(int n, int s, int t, int capacity[MAX][MAX]) {
             }
         }
     }
+#endif
     return maxFlow;
 }
 
-int main() {
+#ifndef EDMOND_KARP_NO_MAIN
+// Loads a DIMACS max-flow file into the capacity matrix.
+// Returns 0 on success, -1 if the file cannot be read or does not fit in MAX.
+int loadDimacs(const char *path, int *n, int *source, int *sink, int capacity[MAX][MAX]) {
+    FILE *in = fopen(path, "r");
+    if (in == NULL) {
+        perror(path);
+        return -1;
+    }
+    FlowNetwork net;
+    int status = readDimacsFlow(in, &net);
+    fclose(in);
+    if (status != 0)
+        return -1;
+    if (net.n > MAX) {
+        fprintf(stderr, "%s has %d vertices; this build supports at most %d (-DMAX=...).\n",
+                path, net.n, MAX);
+        freeFlowNetwork(&net);
+        return -1;
+    }
+    *n = net.n;
+    *source = net.s;
+    *sink = net.t;
+    // Parallel arcs are merged by adding their capacities.
+    for (int i = 0; i < net.m; i++) {
+        const FlowArc *a = &net.arcs[i];
+        if (mergeArcCapacity(&capacity[a->u][a->v], a->capacity) != 0) {
+            fprintf(stderr, "%s: total capacity of the arcs %d -> %d exceeds %d.\n",
+                    path, a->u + 1, a->v + 1, INT_MAX);
+            freeFlowNetwork(&net);
+            return -1;
+        }
+    }
+    freeFlowNetwork(&net);
+    return 0;
+}
+
+// Usage: ./Edmond_Karp [instance.max]
+// With no argument the graph is read interactively.
+int main(int argc, char *argv[]) {
     int n, m;
-    int capacity[MAX][MAX];
-    memset(capacity, 0, sizeof(capacity));
+    int source, sink;
+    static int capacity[MAX][MAX];
+
+    if (argc > 1) {
+        if (loadDimacs(argv[1], &n, &source, &sink, capacity) != 0)
+            return EXIT_FAILURE;
+        int max_flow = edmondKarp(n, source, sink, capacity);
+        printf("\nMax Flow (returned by function) = %d\n", max_flow);
+        printFlowStats("Edmonds-Karp", &ekStats);
+        return 0;
+    }
 
     printf("Enter the number of vertices: ");
     scanf("%d", &n);
@@ -132,7 +212,6 @@ int main() {
         capacity[u][v] = w;
     }
 
-    int source, sink;
     printf("Enter source: ");
     scanf("%d", &source);
     printf("Enter sink: ");
@@ -140,6 +219,8 @@ int main() {
 
     int max_flow = edmondKarp(n, source, sink, capacity);
     printf("\nMax Flow (returned by function) = %d\n", max_flow);
+    printFlowStats("Edmonds-Karp", &ekStats);
 
     return 0;
 }
+#endif
@@ -2,13 +2,20 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include "flow_stats.h"
+#include "dimacs_flow.h"
+
+#ifndef MAX
 #define MAX 100  // Maximum number of vertices
+#endif
 
 // Global matrices for capacities, flows, and residual capacities.
 int capacity[MAX][MAX];
 int flow[MAX][MAX];
 int residual[MAX][MAX];
 
+FlowStats ffStats;  // counters for the most recent fordFulkerson() call
+
 // DFS to find an augmenting path from 's' to 't'.
 // It marks visited vertices and fills the parent[] array to record the path.
 // Returns 1 if a path is found, 0 otherwise.
@@ -16,6 +23,7 @@ int dfs(int s, int t, int n, int visited[MAX], int parent[MAX]) {
     if (s == t)
         return 1;
     visited[s] = 1;
+    ffStats.edgesScanned += n;
     for (int v = 0; v < n; v++) {
         if (!visited[v] && residual[s][v] > 0) {
             parent[v] = s;
@@ -26,8 +34,12 @@ int dfs(int s, int t, int n, int visited[MAX], int parent[MAX]) {
     return 0;
 }
 
-// This function prints each augmenting path and the corresponding flow updates.
+// With TRACE enabled this function prints each augmenting path and the
+// corresponding flow updates; otherwise it only fills ffStats.
 int fordFulkerson(int n, int s, int t) {
+    memset(&ffStats, 0, sizeof(ffStats));
+    clock_t phase = clock();
+
     // Initialize flows to 0 and residual capacities equal to the capacities.
     memset(flow, 0, sizeof(flow));
     for (int u = 0; u < n; u++) {
@@ -35,9 +47,12 @@ int fordFulkerson(int n, int s, int t) {
             residual[u][v] = capacity[u][v];
         }
     }
+    ffStats.initTime = elapsedSeconds(phase);
     
     int maxFlow = 0;
+#if TRACE
     int iteration = 1;
+#endif
     int parent[MAX];
     
     // While an augmenting path exists in the residual graph:
@@ -45,8 +60,13 @@ int fordFulkerson(int n, int s, int t) {
         int visited[MAX] = {0};
         memset(parent, -1, sizeof(parent));
         
-        if (!dfs(s, t, n, visited, parent))
+        phase = clock();
+        int found = dfs(s, t, n, visited, parent);
+        ffStats.searchTime += elapsedSeconds(phase);
+        if (!found)
             break;  // No path found; exit loop.
+        phase = clock();
+        ffStats.augmentations++;
         
         // Find the bottleneck capacity along the path found.
         int path_flow = 1e9;  // Start with a very large number.
@@ -58,6 +78,7 @@ int fordFulkerson(int n, int s, int t) {
             v = u;
         }
         
+#if TRACE
         // Print the augmenting path.
         printf("\nIteration %d:\n", iteration++);
         printf("Augmenting path (from sink to source): ");
@@ -68,10 +89,11 @@ int fordFulkerson(int n, int s, int t) {
         }
         printf("%d\n", s);
         printf("Bottleneck capacity = %d\n", path_flow);
+        printf("Updated flow on edges in the path:\n");
+#endif
         
         // Update flows and residual capacities along the path.
         v = t;
-        printf("Updated flow on edges in the path:\n");
         while (v != s) {
             int u = parent[v];
             // If edge (u,v) is in the original graph then capacity[u][v] > 0.
@@ -84,15 +106,20 @@ int fordFulkerson(int n, int s, int t) {
             // Update the residual network.
             residual[u][v] -= path_flow;
             residual[v][u] += path_flow;
+            ffStats.residualUpdates += 2;
             
+#if TRACE
             printf("  Edge (%d -> %d): flow = %d / capacity = %d\n", 
                    u, v, flow[u][v], capacity[u][v]);
+#endif
             v = u;
         }
         
         maxFlow += path_flow;
+        ffStats.augmentTime += elapsedSeconds(phase);
     }
     
+#if FLOW_REPORT
     printf("\nNo more augmenting paths. Maximum Flow = %d\n", maxFlow);
     
     // Print final flow for each edge (only those with positive capacity).
@@ -105,11 +132,62 @@ int fordFulkerson(int n, int s, int t) {
             }
         }
     }
+#endif
     return maxFlow;
 }
 
-int main() {
+#ifndef FORD_FULKERSON_NO_MAIN
+// Loads a DIMACS max-flow file into the global capacity matrix.
+// Returns 0 on success, -1 if the file cannot be read or does not fit in MAX.
+int loadDimacs(const char *path, int *n, int *source, int *sink) {
+    FILE *in = fopen(path, "r");
+    if (in == NULL) {
+        perror(path);
+        return -1;
+    }
+    FlowNetwork net;
+    int status = readDimacsFlow(in, &net);
+    fclose(in);
+    if (status != 0)
+        return -1;
+    if (net.n > MAX) {
+        fprintf(stderr, "%s has %d vertices; this build supports at most %d (-DMAX=...).\n",
+                path, net.n, MAX);
+        freeFlowNetwork(&net);
+        return -1;
+    }
+    *n = net.n;
+    *source = net.s;
+    *sink = net.t;
+    memset(capacity, 0, sizeof(capacity));
+    // Parallel arcs are merged by adding their capacities.
+    for (int i = 0; i < net.m; i++) {
+        const FlowArc *a = &net.arcs[i];
+        if (mergeArcCapacity(&capacity[a->u][a->v], a->capacity) != 0) {
+            fprintf(stderr, "%s: total capacity of the arcs %d -> %d exceeds %d.\n",
+                    path, a->u + 1, a->v + 1, INT_MAX);
+            freeFlowNetwork(&net);
+            return -1;
+        }
+    }
+    freeFlowNetwork(&net);
+    return 0;
+}
+
+// Usage: ./Fork_Fulkerson [instance.max]
+// With no argument the graph is read interactively.
+int main(int argc, char *argv[]) {
     int n, m;  
+    if (argc > 1) {
+        int source, sink;
+        if (loadDimacs(argv[1], &n, &source, &sink) != 0)
+            return EXIT_FAILURE;
+        int max_flow = fordFulkerson(n, source, sink);
+        printf("\nMax Flow (returned by function) = %d\n", max_flow);
+        printFlowStats("Ford-Fulkerson", &ffStats);
+        return 0;
+    }
+
     printf("Enter the number of vertices: ");
     scanf("%d", &n);
     printf("Enter the number of edges: ");
@@ -130,6 +208,8 @@ int main() {
     scanf("%d", &sink);
     int max_flow = fordFulkerson(n, source, sink);
     printf("\nMax Flow (returned by function) = %d\n", max_flow);
+    printFlowStats("Ford-Fulkerson", &ffStats);
     
     return 0;
 }
+#endif
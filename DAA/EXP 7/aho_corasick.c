@@ -0,0 +1,253 @@
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+
+#include "string_match.h"
+
+/*
+ * Aho-Corasick multi-pattern matching.
+ *
+ * This is computePrefixFunction() from kmp.c generalised from one pattern to
+ * a trie of patterns: for a trie state u (a prefix of some pattern), fail[u]
+ * is the longest proper suffix of u that is also a state of the trie - the
+ * same quantity prefixArray[] stores for a single pattern. The failure links
+ * are folded into a complete transition table (a DFA), so the scan does one
+ * table load per text byte and never backtracks, exactly like KMP's q but
+ * for every pattern at once.
+ *
+ * Cache-compact table: only bytes that occur in some pattern get their own
+ * column; all other bytes share column 0, which always leads back to the
+ * root. The table is one flat int array of states x columns.
+ *
+ * dictLink[u] points to the nearest state on u's failure chain that ends a
+ * pattern, so reporting all matches at a position only visits states that
+ * actually produce output.
+ */
+
+typedef struct {
+    int numStates, stateCapacity;
+    int numColumns;            // distinct pattern bytes + 1
+    unsigned char column[256]; // byte -> column index (0 = not in any pattern)
+    int *delta;                // delta[state * numColumns + column]
+    int *fail;                 // failure link (prefix function on the trie)
+    int *dictLink;             // next output state on the failure chain, -1 if none
+    int *firstPattern;         // first pattern ending exactly at this state, -1 if none
+    int *nextPattern;          // nextPattern[id] = next pattern with the same string
+    int *patternLength;
+    int numPatterns;
+} AhoCorasick;
+
+static int acNewState(AhoCorasick *ac) {
+    if (ac->numStates == ac->stateCapacity) {
+        ac->stateCapacity *= 2;
+        ac->delta = (int *)realloc(ac->delta,
+                                   (size_t)ac->stateCapacity * ac->numColumns * sizeof(int));
+        ac->firstPattern = (int *)realloc(ac->firstPattern, ac->stateCapacity * sizeof(int));
+        if (ac->delta == NULL || ac->firstPattern == NULL) {
+            fprintf(stderr, "Memory allocation failed.\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+    int s = ac->numStates++;
+    for (int c = 0; c < ac->numColumns; c++)
+        ac->delta[(size_t)s * ac->numColumns + c] = -1;
+    ac->firstPattern[s] = -1;
+    return s;
+}
+
+/*
+ * Function: buildAhoCorasick
+ * --------------------------
+ * Builds the automaton for 'count' NUL-terminated patterns. Pattern i is
+ * reported with id i. Empty patterns are ignored.
+ */
+AhoCorasick *buildAhoCorasick(const char *const *patterns, int count) {
+    AhoCorasick *ac = (AhoCorasick *)calloc(1, sizeof(AhoCorasick));
+
+    // Assign columns only to bytes that appear in some pattern.
+    ac->numColumns = 1;
+    for (int i = 0; i < count; i++) {
+        for (const unsigned char *p = (const unsigned char *)patterns[i]; *p; p++) {
+            if (ac->column[*p] == 0)
+                ac->column[*p] = (unsigned char)ac->numColumns++;
+        }
+    }
+
+    ac->stateCapacity = 64;
+    ac->delta = (int *)malloc((size_t)ac->stateCapacity * ac->numColumns * sizeof(int));
+    ac->firstPattern = (int *)malloc(ac->stateCapacity * sizeof(int));
+    ac->nextPattern = (int *)malloc((count > 0 ? count : 1) * sizeof(int));
+    ac->patternLength = (int *)malloc((count > 0 ? count : 1) * sizeof(int));
+    ac->numPatterns = count;
+    acNewState(ac);  // root = 0
+
+    // 1. Insert every pattern into the trie.
+    for (int i = 0; i < count; i++) {
+        int state = 0;
+        ac->patternLength[i] = (int)strlen(patterns[i]);
+        ac->nextPattern[i] = -1;
+        if (ac->patternLength[i] == 0)
+            continue;
+        for (const unsigned char *p = (const unsigned char *)patterns[i]; *p; p++) {
+            size_t slot = (size_t)state * ac->numColumns + ac->column[*p];
+            if (ac->delta[slot] == -1) {
+                int next = acNewState(ac);
+                ac->delta[slot] = next;  // slot is an index: acNewState may realloc delta
+            }
+            state = ac->delta[slot];
+        }
+        ac->nextPattern[i] = ac->firstPattern[state];
+        ac->firstPattern[state] = i;
+    }
+
+    // 2. Breadth-first pass: failure links, dictionary links, and completing
+    //    the missing transitions so the table becomes a DFA.
+    int n = ac->numStates, k = ac->numColumns;
+    ac->fail = (int *)malloc(n * sizeof(int));
+    ac->dictLink = (int *)malloc(n * sizeof(int));
+    int *queue = (int *)malloc(n * sizeof(int));
+    int front = 0, rear = 0;
+
+    ac->fail[0] = 0;
+    ac->dictLink[0] = -1;
+    for (int c = 0; c < k; c++) {
+        int v = ac->delta[c];
+        if (v == -1 || c == 0) {
+            ac->delta[c] = 0;
+        } else {
+            ac->fail[v] = 0;
+            ac->dictLink[v] = -1;
+            queue[rear++] = v;
+        }
+    }
+    while (front < rear) {
+        int u = queue[front++];
+        int *row = &ac->delta[(size_t)u * k];
+        const int *failRow = &ac->delta[(size_t)ac->fail[u] * k];
+        for (int c = 0; c < k; c++) {
+            int v = row[c];
+            if (v == -1) {
+                row[c] = failRow[c];
+            } else {
+                int f = failRow[c];
+                ac->fail[v] = f;
+                ac->dictLink[v] = (ac->firstPattern[f] != -1) ? f : ac->dictLink[f];
+                queue[rear++] = v;
+            }
+        }
+    }
+    free(queue);
+    return ac;
+}
+
+void freeAhoCorasick(AhoCorasick *ac) {
+    free(ac->delta);
+    free(ac->fail);
+    free(ac->dictLink);
+    free(ac->firstPattern);
+    free(ac->nextPattern);
+    free(ac->patternLength);
+    free(ac);
+}
+
+/*
+ * Function: ahoCorasickScan
+ * -------------------------
+ * Feeds 'len' bytes of text through the automaton starting in *state, and
+ * calls report(patternId, offset) for every match. 'base' is the absolute
+ * offset of text[0], so a text can be scanned in consecutive chunks by
+ * passing the same *state and increasing 'base'; matches that span a chunk
+ * boundary are still found. Returns the number of matches reported.
+ */
+long long ahoCorasickScan(const AhoCorasick *ac, int *state, const char *text, size_t len,
+                          long long base, MultiMatchCallback report, void *ctx) {
+    const int *delta = ac->delta;
+    const unsigned char *column = ac->column;
+    int k = ac->numColumns;
+    int s = *state;
+    long long matches = 0;
+
+    for (size_t i = 0; i < len; i++) {
+        s = delta[(size_t)s * k + column[(unsigned char)text[i]]];
+        int out = (ac->firstPattern[s] != -1) ? s : ac->dictLink[s];
+        while (out != -1) {
+            for (int id = ac->firstPattern[out]; id != -1; id = ac->nextPattern[id]) {
+                report(id, base + (long long)i - ac->patternLength[id] + 1, ctx);
+                matches++;
+            }
+            out = ac->dictLink[out];
+        }
+    }
+    *state = s;
+    return matches;
+}
+
+#ifndef AHO_CORASICK_NO_MAIN
+static void printMatch(int patternId, long long offset, void *ctx) {
+    const char *const *patterns = (const char *const *)ctx;
+    printf("Pattern %d (\"%s\") found at index %lld\n", patternId, patterns[patternId], offset);
+}
+
+// Usage: ./aho_corasick [text-file]
+// Patterns are read from stdin; the text is the next stdin line, or the
+// whole file when a path is given (scanned in chunks, one pass).
+int main(int argc, char *argv[]) {
+    int count;
+    printf("Enter the number of patterns: ");
+    if (scanf("%d", &count) != 1 || count <= 0) {
+        fprintf(stderr, "Invalid number of patterns.\n");
+        return EXIT_FAILURE;
+    }
+    getchar();  // consume the newline after the count
+
+    char **patterns = (char **)malloc(count * sizeof(char *));
+    char line[1000];
+    for (int i = 0; i < count; i++) {
+        printf("Enter pattern %d: ", i);
+        if (fgets(line, sizeof(line), stdin) == NULL) {
+            fprintf(stderr, "Error reading pattern.\n");
+            return EXIT_FAILURE;
+        }
+        line[strcspn(line, "\n")] = '\0';
+        patterns[i] = (char *)malloc(strlen(line) + 1);
+        strcpy(patterns[i], line);
+    }
+
+    AhoCorasick *ac = buildAhoCorasick((const char *const *)patterns, count);
+    printf("Automaton: %d states x %d columns\n", ac->numStates, ac->numColumns);
+
+    int state = 0;
+    long long total = 0;
+    if (argc > 1) {
+        FILE *in = fopen(argv[1], "rb");
+        if (in == NULL) {
+            perror(argv[1]);
+            return EXIT_FAILURE;
+        }
+        static char chunk[1 << 16];
+        long long base = 0;
+        size_t got;
+        while ((got = fread(chunk, 1, sizeof(chunk), in)) > 0) {
+            total += ahoCorasickScan(ac, &state, chunk, got, base, printMatch, patterns);
+            base += (long long)got;
+        }
+        fclose(in);
+    } else {
+        char text[1000];
+        printf("Enter the text: ");
+        if (fgets(text, sizeof(text), stdin) == NULL) {
+            fprintf(stderr, "Error reading text.\n");
+            return EXIT_FAILURE;
+        }
+        text[strcspn(text, "\n")] = '\0';
+        total = ahoCorasickScan(ac, &state, text, strlen(text), 0, printMatch, patterns);
+    }
+    printf("Total matches: %lld\n", total);
+
+    freeAhoCorasick(ac);
+    for (int i = 0; i < count; i++)
+        free(patterns[i]);
+    free(patterns);
+    return EXIT_SUCCESS;
+}
+#endif
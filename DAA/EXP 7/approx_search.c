@@ -0,0 +1,184 @@
+/*
+ * Approximate pattern search: every text position where some substring
+ * ending there is within edit distance k (insertions, deletions,
+ * substitutions) of the pattern.
+ *
+ * Myers' bit-parallel algorithm computes one column of the edit-distance DP
+ * table per text byte using a handful of word operations. Instead of
+ * storing the column, it keeps the vertical differences D[i][j] - D[i-1][j]
+ * as two bitmasks (Pv = +1, Mv = -1), one bit per pattern position. The DP
+ * is the semi-global one (row 0 is all zeros), so a match may start
+ * anywhere and the score of the last row is the best distance of a match
+ * ending at the current byte.
+ *
+ * Patterns longer than 64 bytes are split into 64-bit blocks (Hyyro's
+ * block variant); each block passes its horizontal delta at the top row of
+ * the next block as a carry, so cost is O(ceil(m / 64)) words per byte.
+ *
+ * Usage: ./approx_search [text-file]   (pattern and k from stdin)
+ * Compile with: gcc -O2 -o approx_search approx_search.c
+ */
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+#include "string_match.h"
+
+typedef struct {
+    uint64_t Pv, Mv;   // vertical +1 / -1 deltas of this block's rows
+} MyersBlock;
+
+typedef struct {
+    int m;
+    int blocks;
+    uint64_t lastRowBit;   // bit of row m inside the last block
+    uint64_t *peq;         // peq[c * blocks + b]: rows of block b equal to byte c
+    MyersBlock *state;
+    int score;             // D[m][j] for the current column
+} MyersMatcher;
+
+void initMyers(MyersMatcher *mm, const char *pattern, int m) {
+    mm->m = m;
+    mm->blocks = (m + 63) / 64;
+    mm->lastRowBit = 1ULL << ((m - 1) % 64);
+    mm->peq = (uint64_t *)calloc((size_t)256 * mm->blocks, sizeof(uint64_t));
+    mm->state = (MyersBlock *)malloc(mm->blocks * sizeof(MyersBlock));
+    if (mm->peq == NULL || mm->state == NULL) {
+        fprintf(stderr, "Memory allocation failed.\n");
+        exit(EXIT_FAILURE);
+    }
+    for (int i = 0; i < m; i++)
+        mm->peq[(size_t)(unsigned char)pattern[i] * mm->blocks + i / 64] |= 1ULL << (i % 64);
+    for (int b = 0; b < mm->blocks; b++) {
+        mm->state[b].Pv = ~0ULL;   // column 0 is 0, 1, 2, ..., m
+        mm->state[b].Mv = 0;
+    }
+    mm->score = m;
+}
+
+void freeMyers(MyersMatcher *mm) {
+    free(mm->peq);
+    free(mm->state);
+}
+
+/*
+ * Advances one block by one text byte. hin is the horizontal delta
+ * (-1, 0, +1) entering the block's top row; returns the delta leaving its
+ * bottom row ('highBit' marks that row).
+ */
+static int advanceBlock(MyersBlock *blk, uint64_t eq, int hin, uint64_t highBit) {
+    uint64_t Pv = blk->Pv, Mv = blk->Mv;
+    uint64_t Xv = eq | Mv;
+    if (hin < 0)
+        eq |= 1;
+    uint64_t Xh = (((eq & Pv) + Pv) ^ Pv) | eq;
+    uint64_t Ph = Mv | ~(Xh | Pv);
+    uint64_t Mh = Pv & Xh;
+
+    int hout = 0;
+    if (Ph & highBit)
+        hout = 1;
+    else if (Mh & highBit)
+        hout = -1;
+
+    Ph <<= 1;
+    Mh <<= 1;
+    if (hin < 0)
+        Mh |= 1;
+    else if (hin > 0)
+        Ph |= 1;
+    blk->Pv = Mh | ~(Xv | Ph);
+    blk->Mv = Ph & Xv;
+    return hout;
+}
+
+/*
+ * Function: approxScan
+ * --------------------
+ * Feeds text[0..n) through the matcher and reports the offset of every
+ * byte where a match with at most k errors ends. The state persists in
+ * 'mm', so a long input may be fed in consecutive chunks ('base' is the
+ * absolute offset of text[0]). Returns the number of reported positions.
+ */
+long long approxScan(MyersMatcher *mm, const char *text, size_t n, int k, long long base,
+                     MatchCallback report, void *ctx) {
+    long long hits = 0;
+    int blocks = mm->blocks;
+    for (size_t j = 0; j < n; j++) {
+        const uint64_t *eq = &mm->peq[(size_t)(unsigned char)text[j] * blocks];
+        int carry = 0;  // semi-global: row 0 stays 0, so no delta enters block 0
+        for (int b = 0; b < blocks; b++) {
+            uint64_t highBit = (b == blocks - 1) ? mm->lastRowBit : (1ULL << 63);
+            carry = advanceBlock(&mm->state[b], eq[b], carry, highBit);
+        }
+        mm->score += carry;
+        if (mm->score <= k) {
+            report(base + (long long)j, ctx);
+            hits++;
+        }
+    }
+    return hits;
+}
+
+#ifndef APPROX_SEARCH_NO_MAIN
+static void printMatchEnd(long long offset, void *ctx) {
+    const MyersMatcher *mm = (const MyersMatcher *)ctx;
+    printf("Match ending at index %lld (distance %d)\n", offset, mm->score);
+}
+
+int main(int argc, char *argv[]) {
+    char text[1000];
+    char pattern[1000];
+    int k;
+
+    if (argc < 2) {
+        printf("Enter the text: ");
+        if (fgets(text, sizeof(text), stdin) == NULL) {
+            fprintf(stderr, "Error reading text.\n");
+            return EXIT_FAILURE;
+        }
+        text[strcspn(text, "\n")] = '\0';
+    }
+    printf("Enter the pattern: ");
+    if (fgets(pattern, sizeof(pattern), stdin) == NULL) {
+        fprintf(stderr, "Error reading pattern.\n");
+        return EXIT_FAILURE;
+    }
+    pattern[strcspn(pattern, "\n")] = '\0';
+    printf("Enter the maximum number of errors k: ");
+    if (scanf("%d", &k) != 1 || k < 0) {
+        fprintf(stderr, "Invalid k.\n");
+        return EXIT_FAILURE;
+    }
+    int m = (int)strlen(pattern);
+    if (m == 0) {
+        fprintf(stderr, "Pattern must not be empty.\n");
+        return EXIT_FAILURE;
+    }
+
+    MyersMatcher mm;
+    initMyers(&mm, pattern, m);
+    long long hits = 0;
+    if (argc > 1) {
+        FILE *in = fopen(argv[1], "rb");
+        if (in == NULL) {
+            perror(argv[1]);
+            return EXIT_FAILURE;
+        }
+        static char chunk[1 << 16];
+        long long base = 0;
+        size_t got;
+        while ((got = fread(chunk, 1, sizeof(chunk), in)) > 0) {
+            hits += approxScan(&mm, chunk, got, k, base, printMatchEnd, &mm);
+            base += (long long)got;
+        }
+        fclose(in);
+    } else {
+        hits = approxScan(&mm, text, strlen(text), k, 0, printMatchEnd, &mm);
+    }
+    printf("Positions within distance %d: %lld\n", k, hits);
+    freeMyers(&mm);
+    return EXIT_SUCCESS;
+}
+#endif
@@ -0,0 +1,224 @@
+#ifndef DIMACS_FLOW_H
+#define DIMACS_FLOW_H
+
+/*
+ * DIMACS max-flow format reader / writer.
+ *
+ * Format (vertices are 1-based in the file, 0-based in FlowNetwork):
+ *   c <comment>
+ *   p max <nodes> <arcs>
+ *   n <id> s
+ *   n <id> t
+ *   a <from> <to> <capacity>
+ *
+ * The reader pulls the file through a 64 KiB buffer and parses numbers by
+ * hand, so large instances load at disk speed instead of scanf speed.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <limits.h>
+
+typedef struct {
+    int u, v;
+    int capacity;
+} FlowArc;
+
+typedef struct {
+    int n;            // number of vertices
+    int s, t;         // source and sink (0-based)
+    int m;            // number of arcs stored
+    int arcCapacity;  // allocated length of arcs[]
+    FlowArc *arcs;
+} FlowNetwork;
+
+void initFlowNetwork(FlowNetwork *net, int n, int s, int t) {
+    net->n = n;
+    net->s = s;
+    net->t = t;
+    net->m = 0;
+    net->arcCapacity = 0;
+    net->arcs = NULL;
+}
+
+void addFlowArc(FlowNetwork *net, int u, int v, int capacity) {
+    if (net->m == net->arcCapacity) {
+        net->arcCapacity = net->arcCapacity ? 2 * net->arcCapacity : 64;
+        net->arcs = (FlowArc *)realloc(net->arcs, net->arcCapacity * sizeof(FlowArc));
+        if (net->arcs == NULL) {
+            fprintf(stderr, "Memory allocation failed.\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+    net->arcs[net->m].u = u;
+    net->arcs[net->m].v = v;
+    net->arcs[net->m].capacity = capacity;
+    net->m++;
+}
+
+// Adds an arc's capacity to a capacity-matrix cell, as the matrix solvers
+// do for parallel arcs. Returns -1 (cell unchanged) if the sum would not
+// fit in an int.
+int mergeArcCapacity(int *cell, int capacity) {
+    if (capacity > INT_MAX - *cell)
+        return -1;
+    *cell += capacity;
+    return 0;
+}
+
+void freeFlowNetwork(FlowNetwork *net) {
+    free(net->arcs);
+    net->arcs = NULL;
+    net->m = net->arcCapacity = 0;
+}
+
+// -------------------------- Buffered reader --------------------------
+typedef struct {
+    FILE *in;
+    char buf[1 << 16];
+    size_t pos, len;
+} DimacsReader;
+
+static int dimacsPeek(DimacsReader *r) {
+    if (r->pos == r->len) {
+        r->len = fread(r->buf, 1, sizeof(r->buf), r->in);
+        r->pos = 0;
+        if (r->len == 0)
+            return EOF;
+    }
+    return (unsigned char)r->buf[r->pos];
+}
+
+static int dimacsGet(DimacsReader *r) {
+    int c = dimacsPeek(r);
+    if (c != EOF)
+        r->pos++;
+    return c;
+}
+
+static void dimacsSkipLine(DimacsReader *r) {
+    int c;
+    while ((c = dimacsGet(r)) != EOF && c != '\n')
+        ;
+}
+
+static void dimacsSkipBlanks(DimacsReader *r) {
+    int c;
+    while ((c = dimacsPeek(r)) == ' ' || c == '\t' || c == '\r')
+        r->pos++;
+}
+
+// Reads a (possibly negative) integer; returns 0 if none is present.
+static int dimacsInt(DimacsReader *r, long *out) {
+    dimacsSkipBlanks(r);
+    int c = dimacsPeek(r), neg = 0;
+    if (c == '-') {
+        neg = 1;
+        r->pos++;
+        c = dimacsPeek(r);
+    }
+    if (c < '0' || c > '9')
+        return 0;
+    long value = 0;
+    while ((c = dimacsPeek(r)) >= '0' && c <= '9') {
+        value = value * 10 + (c - '0');
+        r->pos++;
+    }
+    *out = neg ? -value : value;
+    return 1;
+}
+
+/*
+ * Function: readDimacsFlow
+ * ------------------------
+ * Parses a DIMACS max-flow instance from 'in' into 'net'.
+ * Returns 0 on success, -1 (after printing the offending line) on error.
+ */
+int readDimacsFlow(FILE *in, FlowNetwork *net) {
+    DimacsReader *r = (DimacsReader *)malloc(sizeof(DimacsReader));
+    if (r == NULL) {
+        fprintf(stderr, "Memory allocation failed.\n");
+        return -1;
+    }
+    r->in = in;
+    r->pos = r->len = 0;
+    initFlowNetwork(net, 0, -1, -1);
+
+    long line = 0, declaredArcs = 0;
+    int c, ok = 1, sawProblem = 0;
+    while (ok && (c = dimacsPeek(r)) != EOF) {
+        line++;
+        if (c == 'c' || c == '\n' || c == '\r') {
+            dimacsSkipLine(r);
+            continue;
+        }
+        r->pos++;
+        if (c == 'p') {
+            dimacsSkipBlanks(r);
+            // expect the literal "max"
+            if (dimacsGet(r) != 'm' || dimacsGet(r) != 'a' || dimacsGet(r) != 'x') {
+                ok = 0;
+                break;
+            }
+            long n;
+            ok = dimacsInt(r, &n) && dimacsInt(r, &declaredArcs) && n > 0 && n <= INT_MAX;
+            if (ok) {
+                net->n = (int)n;
+                sawProblem = 1;
+            }
+        } else if (c == 'n') {
+            long id;
+            ok = sawProblem && dimacsInt(r, &id) && id >= 1 && id <= net->n;
+            dimacsSkipBlanks(r);
+            int kind = dimacsGet(r);
+            if (ok && kind == 's')
+                net->s = (int)id - 1;
+            else if (ok && kind == 't')
+                net->t = (int)id - 1;
+            else
+                ok = 0;
+        } else if (c == 'a') {
+            long u, v, cap;
+            ok = sawProblem && dimacsInt(r, &u) && dimacsInt(r, &v) && dimacsInt(r, &cap)
+                 && u >= 1 && u <= net->n && v >= 1 && v <= net->n
+                 && cap >= 0 && cap <= INT_MAX;
+            if (ok)
+                addFlowArc(net, (int)u - 1, (int)v - 1, (int)cap);
+        } else {
+            ok = 0;
+        }
+        if (ok)
+            dimacsSkipLine(r);
+    }
+    free(r);
+
+    if (!ok) {
+        fprintf(stderr, "DIMACS parse error on line %ld.\n", line);
+    } else if (!sawProblem || net->s < 0 || net->t < 0) {
+        fprintf(stderr, "DIMACS input is missing the problem line or source/sink.\n");
+        ok = 0;
+    } else if (net->m != declaredArcs) {
+        fprintf(stderr, "Warning: problem line declares %ld arcs, found %d.\n",
+                declaredArcs, net->m);
+    }
+    if (!ok) {
+        freeFlowNetwork(net);
+        return -1;
+    }
+    return 0;
+}
+
+// Writes 'net' in DIMACS max-flow format (1-based ids).
+void writeDimacsFlow(FILE *out, const FlowNetwork *net, const char *comment) {
+    if (comment != NULL)
+        fprintf(out, "c %s\n", comment);
+    fprintf(out, "p max %d %d\n", net->n, net->m);
+    fprintf(out, "n %d s\n", net->s + 1);
+    fprintf(out, "n %d t\n", net->t + 1);
+    for (int i = 0; i < net->m; i++) {
+        fprintf(out, "a %d %d %d\n",
+                net->arcs[i].u + 1, net->arcs[i].v + 1, net->arcs[i].capacity);
+    }
+}
+
+#endif
@@ -0,0 +1,263 @@
+/*
+ * Max-flow benchmark harness.
+ *
+ * Generates instances from three standard DIMACS families, runs every
+ * max-flow solver in this directory on each one (min_cost_flow.c runs
+ * with all costs 0, so it reduces to a max-flow solver), times them and checks
+ * that all solvers agree on the flow value.
+ *
+ *   RMF   (Goldfarb-Grigoriadis): b square a x a grid frames. Arcs inside a
+ *         frame have capacity c2*a*a; each node is joined to a random node
+ *         of the next frame (random permutation) with capacity in [c1, c2].
+ *   WASH  (Washington random level graph): rows x cols grid; every node
+ *         has three arcs to random nodes of the next column, the source
+ *         feeds column 0 and the last column drains into the sink.
+ *   AK    (Cherkassky-Goldberg style): a path with one unit exit per node
+ *         (slow for push/relabel) next to a long path that fans out into
+ *         k unit arcs (k augmentations of length ~k for augmenting paths).
+ *
+ * Usage:
+ *   ./flow_bench                         run the default sweep
+ *   ./flow_bench file1.max file2.max ... benchmark DIMACS files
+ *   ./flow_bench -g rmf  a b c1 c2 seed  write an RMF instance to stdout
+ *   ./flow_bench -g wash rows cols cap seed
+ *   ./flow_bench -g ak   k
+ *
+ * Compile with: gcc -O2 -o flow_bench flow_bench.c
+ */
+
+#define MAX 512
+#define FLOW_REPORT 0
+#define EDMOND_KARP_NO_MAIN
+#define FORD_FULKERSON_NO_MAIN
+#define MIN_COST_FLOW_NO_MAIN
+#include "Edmond_Karp.c"
+#include "Fork_Fulkerson.c"
+#include "min_cost_flow.c"
+
+// -------------------------- Generators --------------------------
+static unsigned long long rngState;
+
+static unsigned int nextRandom(void) {
+    // xorshift64*: fast, reproducible across platforms for a given seed
+    rngState ^= rngState >> 12;
+    rngState ^= rngState << 25;
+    rngState ^= rngState >> 27;
+    return (unsigned int)((rngState * 2685821657736338717ULL) >> 32);
+}
+
+static int randomRange(int lo, int hi) {
+    return lo + (int)(nextRandom() % (unsigned int)(hi - lo + 1));
+}
+
+static void seedRandom(unsigned long long seed) {
+    rngState = seed ? seed : 88172645463325252ULL;
+}
+
+void generateRMF(FlowNetwork *net, int a, int b, int c1, int c2, unsigned long long seed) {
+    int frame = a * a;
+    initFlowNetwork(net, frame * b, 0, frame * b - 1);
+    seedRandom(seed);
+    int *perm = (int *)malloc(frame * sizeof(int));
+
+    for (int k = 0; k < b; k++) {
+        int base = k * frame;
+        // grid arcs inside frame k (both directions)
+        for (int i = 0; i < a; i++) {
+            for (int j = 0; j < a; j++) {
+                int x = base + i * a + j;
+                if (j + 1 < a) {
+                    addFlowArc(net, x, x + 1, c2 * frame);
+                    addFlowArc(net, x + 1, x, c2 * frame);
+                }
+                if (i + 1 < a) {
+                    addFlowArc(net, x, x + a, c2 * frame);
+                    addFlowArc(net, x + a, x, c2 * frame);
+                }
+            }
+        }
+        if (k + 1 == b)
+            break;
+        // random permutation between frame k and frame k+1
+        for (int i = 0; i < frame; i++)
+            perm[i] = i;
+        for (int i = frame - 1; i > 0; i--) {
+            int j = randomRange(0, i);
+            int tmp = perm[i];
+            perm[i] = perm[j];
+            perm[j] = tmp;
+        }
+        for (int i = 0; i < frame; i++)
+            addFlowArc(net, base + i, base + frame + perm[i], randomRange(c1, c2));
+    }
+    free(perm);
+}
+
+void generateWashington(FlowNetwork *net, int rows, int cols, int maxCap, unsigned long long seed) {
+    int n = rows * cols + 2;
+    initFlowNetwork(net, n, rows * cols, rows * cols + 1);
+    seedRandom(seed);
+    int big = maxCap * rows;
+
+    for (int r = 0; r < rows; r++) {
+        addFlowArc(net, net->s, r * cols, big);
+        addFlowArc(net, r * cols + cols - 1, net->t, big);
+    }
+    for (int c = 0; c + 1 < cols; c++) {
+        for (int r = 0; r < rows; r++) {
+            int u = r * cols + c;
+            for (int k = 0; k < 3; k++) {
+                int v = randomRange(0, rows - 1) * cols + c + 1;
+                addFlowArc(net, u, v, randomRange(1, maxCap));
+            }
+        }
+    }
+}
+
+void generateAK(FlowNetwork *net, int k) {
+    // vertices: 0 = s, 1 = t, [2, k+2) first path, [k+2, 2k+2) second path,
+    //           [2k+2, 3k+2) fan-out nodes
+    initFlowNetwork(net, 3 * k + 2, 0, 1);
+    int p = 2, q = k + 2, r = 2 * k + 2;
+
+    addFlowArc(net, 0, p, k);
+    for (int i = 0; i < k; i++) {
+        if (i + 1 < k)
+            addFlowArc(net, p + i, p + i + 1, k - i - 1);
+        addFlowArc(net, p + i, 1, 1);
+    }
+
+    addFlowArc(net, 0, q, k);
+    for (int i = 0; i + 1 < k; i++)
+        addFlowArc(net, q + i, q + i + 1, k);
+    for (int i = 0; i < k; i++) {
+        addFlowArc(net, q + k - 1, r + i, 1);
+        addFlowArc(net, r + i, 1, 1);
+    }
+}
+
+// -------------------------- Harness --------------------------
+static double wallSeconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// Runs every solver on 'net'. Returns 1 if they agree on the flow value.
+int benchNetwork(const char *name, const FlowNetwork *net) {
+    if (net->n > MAX) {
+        printf("%-22s skipped: %d vertices > MAX (%d)\n", name, net->n, MAX);
+        return 1;
+    }
+    // fordFulkerson() works on the global capacity matrix from
+    // Fork_Fulkerson.c; edmondKarp() takes it as a parameter.
+    memset(capacity, 0, sizeof(capacity));
+    for (int i = 0; i < net->m; i++) {
+        const FlowArc *a = &net->arcs[i];
+        if (mergeArcCapacity(&capacity[a->u][a->v], a->capacity) != 0) {
+            printf("%-22s skipped: arcs %d -> %d exceed %d in total\n", name, a->u + 1, a->v + 1,
+                   INT_MAX);
+            return 1;
+        }
+    }
+
+    double start = wallSeconds();
+    int ekFlow = edmondKarp(net->n, net->s, net->t, capacity);
+    double ekTime = wallSeconds() - start;
+
+    start = wallSeconds();
+    int ffFlow = fordFulkerson(net->n, net->s, net->t);
+    double ffTime = wallSeconds() - start;
+
+    CostNetwork *costNet = createCostNetwork(net->n);
+    for (int i = 0; i < net->m; i++)
+        addCostEdge(costNet, net->arcs[i].u, net->arcs[i].v, net->arcs[i].capacity, 0);
+    int ok;
+    start = wallSeconds();
+    FlowResult ssp = minCostMaxFlow(costNet, net->s, net->t, &ok);
+    double sspTime = wallSeconds() - start;
+    freeCostNetwork(costNet);
+
+    int agree = (ekFlow == ffFlow) && (ssp.flow == ekFlow);
+    printf("%-22s %6d %7d | %-14s %10d %9.4f s %8ld aug | %-14s %10d %9.4f s %8ld aug"
+           " | %-14s %10lld %9.4f s %8ld aug | %s\n",
+           name, net->n, net->m,
+           "Edmonds-Karp", ekFlow, ekTime, ekStats.augmentations,
+           "Ford-Fulkerson", ffFlow, ffTime, ffStats.augmentations,
+           "Min-cost SSP", ssp.flow, sspTime, mcfStats.augmentations,
+           agree ? "ok" : "MISMATCH");
+    return agree;
+}
+
+static int generateToStdout(int argc, char *argv[]) {
+    FlowNetwork net;
+    char comment[128];
+    if (argc >= 8 && strcmp(argv[2], "rmf") == 0) {
+        generateRMF(&net, atoi(argv[3]), atoi(argv[4]), atoi(argv[5]), atoi(argv[6]),
+                    strtoull(argv[7], NULL, 10));
+    } else if (argc >= 7 && strcmp(argv[2], "wash") == 0) {
+        generateWashington(&net, atoi(argv[3]), atoi(argv[4]), atoi(argv[5]),
+                           strtoull(argv[6], NULL, 10));
+    } else if (argc >= 4 && strcmp(argv[2], "ak") == 0) {
+        generateAK(&net, atoi(argv[3]));
+    } else {
+        fprintf(stderr, "Usage: %s -g rmf a b c1 c2 seed | -g wash rows cols cap seed | -g ak k\n",
+                argv[0]);
+        return EXIT_FAILURE;
+    }
+    snprintf(comment, sizeof(comment), "generated by flow_bench (%s)", argv[2]);
+    writeDimacsFlow(stdout, &net, comment);
+    freeFlowNetwork(&net);
+    return EXIT_SUCCESS;
+}
+
+int main(int argc, char *argv[]) {
+    if (argc > 1 && strcmp(argv[1], "-g") == 0)
+        return generateToStdout(argc, argv);
+
+    int allAgree = 1;
+    printf("%-22s %6s %7s\n", "instance", "n", "m");
+
+    if (argc > 1) {
+        for (int i = 1; i < argc; i++) {
+            FILE *in = fopen(argv[i], "r");
+            if (in == NULL) {
+                perror(argv[i]);
+                return EXIT_FAILURE;
+            }
+            FlowNetwork net;
+            int status = readDimacsFlow(in, &net);
+            fclose(in);
+            if (status != 0)
+                return EXIT_FAILURE;
+            allAgree &= benchNetwork(argv[i], &net);
+            freeFlowNetwork(&net);
+        }
+        return allAgree ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    char name[64];
+    FlowNetwork net;
+    for (int b = 4; b <= 12; b += 4) {
+        generateRMF(&net, 6, b, 1, 100, 1000 + b);
+        snprintf(name, sizeof(name), "rmf a=6 b=%d", b);
+        allAgree &= benchNetwork(name, &net);
+        freeFlowNetwork(&net);
+    }
+    for (int cols = 10; cols <= 40; cols += 15) {
+        generateWashington(&net, 12, cols, 1000, 2000 + cols);
+        snprintf(name, sizeof(name), "wash 12x%d", cols);
+        allAgree &= benchNetwork(name, &net);
+        freeFlowNetwork(&net);
+    }
+    for (int k = 40; k <= 160; k *= 2) {
+        generateAK(&net, k);
+        snprintf(name, sizeof(name), "ak k=%d", k);
+        allAgree &= benchNetwork(name, &net);
+        freeFlowNetwork(&net);
+    }
+
+    printf("\n%s\n", allAgree ? "All solvers agree on every instance."
+                              : "Solvers DISAGREE on at least one instance!");
+    return allAgree ? EXIT_SUCCESS : EXIT_FAILURE;
+}
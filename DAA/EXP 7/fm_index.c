@@ -0,0 +1,501 @@
+/*
+ * Compressed FM-index for low-memory substring search.
+ *
+ * A suffix array (suffix_array.c) costs 4 bytes per text byte. The FM-index
+ * keeps only:
+ *   - the Burrows-Wheeler transform of text + '$', stored in a Huffman-
+ *     shaped wavelet tree: each symbol takes as many bits as its Huffman
+ *     code, so the BWT costs less than H0 + 1 bits per symbol (H0 = the
+ *     order-0 entropy of the text) plus a 12.5% rank directory;
+ *   - every SAMPLE_RATE-th suffix array value, with a marker bitvector, for
+ *     locate queries (about 2.1 bits per text byte together).
+ * The tree is stored level by level: level l concatenates the bitvectors
+ * of all tree nodes at depth l, so it needs no pointers, only the start of
+ * each node in its level. With the rank directory the BWT takes ~2.6 bits
+ * per base for DNA and ~5.3 bits per byte for English text.
+ *
+ * count  = backward search, O(m H0) rank queries on average;
+ * locate = count, then for each row walk LF until a sampled row,
+ *          O(SAMPLE_RATE H0) per occurrence.
+ *
+ * The index file is a flat, 8-byte aligned image of the structures below,
+ * so loading is a single mmap: queries can start immediately and pages are
+ * only read as they are touched.
+ *
+ * Usage:
+ *   ./fm_index build <text-file> <index-file>
+ *   ./fm_index count <index-file>    (patterns on stdin, one per line)
+ *   ./fm_index locate <index-file>
+ * Compile with: gcc -O2 -o fm_index fm_index.c
+ */
+#define SUFFIX_ARRAY_NO_MAIN
+#include "suffix_array.c"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define FM_MAGIC "FMIDX02"
+#define SAMPLE_RATE 32
+#define MAX_SYMBOLS 257           // every byte value plus '$'
+#define MAX_LEVELS 48             // Huffman depth needs > Fibonacci(depth) symbols; n < 2^31
+#define WORDS_PER_BLOCK 8         // rank directory entry every 512 bits
+
+// -------------------------- Rank-supported bitvector --------------------------
+typedef struct {
+    uint64_t length;              // bits
+    const uint64_t *words;        // (length + 63) / 64 words
+    const uint64_t *blockRank;    // ones before each 512-bit block
+} BitVector;
+
+static uint64_t bitWords(uint64_t length) {
+    return (length + 63) / 64;
+}
+
+static uint64_t rankBlocks(uint64_t length) {
+    return bitWords(length) / WORDS_PER_BLOCK + 1;
+}
+
+static int bitAt(const BitVector *bv, uint64_t i) {
+    return (int)((bv->words[i >> 6] >> (i & 63)) & 1);
+}
+
+// Number of 1 bits in [0, i).
+static uint64_t rank1(const BitVector *bv, uint64_t i) {
+    uint64_t word = i >> 6, block = word / WORDS_PER_BLOCK;
+    uint64_t count = bv->blockRank[block];
+    for (uint64_t w = block * WORDS_PER_BLOCK; w < word; w++)
+        count += (uint64_t)__builtin_popcountll(bv->words[w]);
+    if (i & 63)
+        count += (uint64_t)__builtin_popcountll(bv->words[word] & ((1ULL << (i & 63)) - 1));
+    return count;
+}
+
+// Fills the rank directory of a bitvector whose words are already set.
+static void buildRankDirectory(const uint64_t *words, uint64_t length, uint64_t *blockRank) {
+    uint64_t count = 0, nWords = bitWords(length);
+    for (uint64_t w = 0; w < nWords; w++) {
+        if (w % WORDS_PER_BLOCK == 0)
+            blockRank[w / WORDS_PER_BLOCK] = count;
+        count += (uint64_t)__builtin_popcountll(words[w]);
+    }
+    // rank1(length) reads one entry past the last block when the bitvector
+    // ends exactly on a block boundary.
+    if (nWords % WORDS_PER_BLOCK == 0)
+        blockRank[nWords / WORDS_PER_BLOCK] = count;
+}
+
+// -------------------------- FM-index --------------------------
+// Internal node of the Huffman-shaped wavelet tree. Its bits are
+// level[depth][start, start + size), one per BWT symbol below it.
+typedef struct {
+    uint64_t start;
+    uint64_t startRank;           // ones on its level before 'start'
+    int32_t child[2];             // internal node, or -1 - code for a leaf
+} FMNode;
+
+typedef struct {
+    char magic[8];
+    uint64_t rows;                // n + 1 (text plus the '$' row)
+    uint64_t sigma;               // distinct text bytes
+    uint64_t levels;              // longest Huffman code
+    uint64_t sampleRate;
+    uint64_t sampleCount;
+    uint64_t C[MAX_SYMBOLS + 1];  // C[c] = symbols with code < c
+    uint64_t levelLength[MAX_LEVELS];       // bits on each level
+    uint64_t huffmanCode[MAX_SYMBOLS];      // root-to-leaf path, first bit highest
+    FMNode nodes[MAX_SYMBOLS - 1];          // root = nodes[0], in level order
+    uint16_t symbolToCode[256];   // 0 = byte absent from the text
+    uint8_t codeToSymbol[MAX_SYMBOLS];
+    uint8_t huffmanLength[MAX_SYMBOLS];
+} FMHeader;
+
+typedef struct {
+    const FMHeader *header;
+    BitVector level[MAX_LEVELS];
+    BitVector sampled;            // row i has a stored SA value
+    const uint32_t *samples;      // SA values of sampled rows, in row order
+    void *mapping;
+    size_t mappingSize;
+} FMIndex;
+
+// Symbol code of BWT row i; *rank receives its occurrences in BWT[0, i),
+// which is where the walk down the tree ends anyway.
+static unsigned int fmAccess(const FMIndex *fm, uint64_t i, uint64_t *rank) {
+    const FMHeader *h = fm->header;
+    int32_t node = h->levels > 0 ? 0 : -1;    // an empty text has only '$'
+    for (uint64_t l = 0; node >= 0; l++) {
+        const FMNode *nd = &h->nodes[node];
+        const BitVector *bv = &fm->level[l];
+        int bit = bitAt(bv, nd->start + i);
+        uint64_t ones = rank1(bv, nd->start + i) - nd->startRank;
+        i = bit ? ones : i - ones;
+        node = nd->child[bit];
+    }
+    *rank = i;
+    return (unsigned int)(-1 - node);
+}
+
+// Occurrences of symbol code c in BWT[0, i): i is mapped into each node on
+// the path to c's leaf.
+static uint64_t fmRank(const FMIndex *fm, unsigned int c, uint64_t i) {
+    const FMHeader *h = fm->header;
+    unsigned int length = h->huffmanLength[c];
+    int32_t node = 0;
+    for (unsigned int l = 0; l < length; l++) {
+        const FMNode *nd = &h->nodes[node];
+        int bit = (int)((h->huffmanCode[c] >> (length - 1 - l)) & 1);
+        uint64_t ones = rank1(&fm->level[l], nd->start + i) - nd->startRank;
+        i = bit ? ones : i - ones;
+        node = nd->child[bit];
+    }
+    return i;
+}
+
+/*
+ * Function: fmCount
+ * -----------------
+ * Backward search: processes the pattern right to left, narrowing the
+ * block [*sp, *ep) of rows whose suffix starts with the processed part.
+ * Returns the number of occurrences.
+ */
+uint64_t fmCount(const FMIndex *fm, const char *pattern, uint64_t *sp, uint64_t *ep) {
+    const FMHeader *h = fm->header;
+    uint64_t lo = 0, hi = h->rows;
+    for (size_t k = strlen(pattern); k > 0 && lo < hi; k--) {
+        unsigned int c = h->symbolToCode[(unsigned char)pattern[k - 1]];
+        if (c == 0) {
+            lo = hi = 0;
+            break;
+        }
+        lo = h->C[c] + fmRank(fm, c, lo);
+        hi = h->C[c] + fmRank(fm, c, hi);
+    }
+    *sp = lo;
+    *ep = hi;
+    return hi > lo ? hi - lo : 0;
+}
+
+// Text position of the suffix in row i: LF-walk to the nearest sampled row.
+uint64_t fmLocate(const FMIndex *fm, uint64_t i) {
+    uint64_t steps = 0;
+    while (!bitAt(&fm->sampled, i)) {
+        uint64_t rank;
+        unsigned int c = fmAccess(fm, i, &rank);
+        i = fm->header->C[c] + rank;
+        steps++;
+    }
+    return fm->samples[rank1(&fm->sampled, i)] + steps;
+}
+
+// -------------------------- Build / serialise --------------------------
+static size_t align8(size_t bytes) {
+    return (bytes + 7) & ~(size_t)7;
+}
+
+static int writeAll(FILE *out, const void *data, size_t bytes) {
+    static const char pad[8] = {0};
+    size_t padded = align8(bytes);
+    return fwrite(data, 1, bytes, out) == bytes &&
+           fwrite(pad, 1, padded - bytes, out) == padded - bytes;
+}
+
+/*
+ * Function: buildFMIndex
+ * ----------------------
+ * Builds the FM-index of text[0..n) and writes it to 'path'.
+ * Returns the size of the index file in bytes, or -1 on error.
+ */
+long long buildFMIndex(const unsigned char *text, int n, const char *path) {
+    FMHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, FM_MAGIC, 8);
+    uint64_t rows = (uint64_t)n + 1;
+    header.rows = rows;
+    header.sampleRate = SAMPLE_RATE;
+
+    // Alphabet: code 0 is '$', present bytes get codes 1..sigma in byte order.
+    uint64_t freq[256] = {0};
+    for (int i = 0; i < n; i++)
+        freq[text[i]]++;
+    uint64_t weight[2 * MAX_SYMBOLS] = {1};     // per code ($ occurs once), then per merged tree
+    for (int b = 0; b < 256; b++) {
+        if (freq[b] > 0) {
+            header.sigma++;
+            header.symbolToCode[b] = (uint16_t)header.sigma;
+            header.codeToSymbol[header.sigma] = (uint8_t)b;
+            weight[header.sigma] = freq[b];
+        }
+    }
+    header.C[0] = 0;
+    header.C[1] = 1;  // the single '$'
+    for (uint64_t c = 1; c <= header.sigma; c++)
+        header.C[c + 1] = header.C[c] + freq[header.codeToSymbol[c]];
+
+    // Huffman tree over the sigma + 1 codes: repeatedly merge the two
+    // lightest roots. Trees are ids 0..sigma (leaves) and sigma+1.. (merged).
+    int leaves = (int)header.sigma + 1, trees = leaves;
+    int merged[MAX_SYMBOLS][2];
+    int alive[2 * MAX_SYMBOLS], aliveCount = leaves;
+    for (int c = 0; c < leaves; c++)
+        alive[c] = c;
+    while (aliveCount > 1) {
+        int pick[2];
+        for (int k = 0; k < 2; k++) {
+            int best = 0;
+            for (int j = 1; j < aliveCount; j++) {
+                if (weight[alive[j]] < weight[alive[best]])
+                    best = j;
+            }
+            pick[k] = alive[best];
+            alive[best] = alive[--aliveCount];
+        }
+        merged[trees - leaves][0] = pick[0];
+        merged[trees - leaves][1] = pick[1];
+        weight[trees] = weight[pick[0]] + weight[pick[1]];
+        alive[aliveCount++] = trees++;
+    }
+
+    // Breadth-first from the root numbers the internal nodes in level order
+    // and lays each level out as its nodes' bitvectors side by side.
+    int queue[2 * MAX_SYMBOLS], depth[2 * MAX_SYMBOLS], nodeDepth[MAX_SYMBOLS - 1];
+    uint64_t prefix[2 * MAX_SYMBOLS];           // code bits from the root
+    int head = 0, tail = 0, internal = 0, numbered = 1;
+    queue[tail] = trees - 1;
+    depth[tail] = 0;
+    prefix[tail++] = 0;
+    while (head < tail) {
+        int id = queue[head], d = depth[head];
+        uint64_t code = prefix[head++];
+        if (id < leaves) {
+            header.huffmanCode[id] = code;
+            header.huffmanLength[id] = (uint8_t)d;
+            continue;
+        }
+        if (d >= MAX_LEVELS) {
+            fprintf(stderr, "Huffman code longer than %d bits.\n", MAX_LEVELS);
+            return -1;
+        }
+        nodeDepth[internal] = d;
+        FMNode *node = &header.nodes[internal++];
+        node->start = header.levelLength[d];
+        header.levelLength[d] += weight[id];
+        if ((uint64_t)d + 1 > header.levels)
+            header.levels = (uint64_t)d + 1;
+        for (int bit = 0; bit < 2; bit++) {
+            int child = merged[id - leaves][bit];
+            // Internal nodes are numbered in the order they are queued.
+            node->child[bit] = child < leaves ? -1 - child : numbered++;
+            queue[tail] = child;
+            depth[tail] = d + 1;
+            prefix[tail++] = (code << 1) | (uint64_t)bit;
+        }
+    }
+
+    // BWT from the suffix array; row 0 is the '$' suffix.
+    int *sa = (int *)malloc((n > 0 ? n : 1) * sizeof(int));
+    uint16_t *bwt = (uint16_t *)malloc(rows * sizeof(uint16_t));
+    if (sa == NULL || bwt == NULL) {
+        fprintf(stderr, "Memory allocation failed.\n");
+        return -1;
+    }
+    buildSuffixArray(text, n, sa);
+    bwt[0] = n > 0 ? header.symbolToCode[text[n - 1]] : 0;
+    for (int i = 0; i < n; i++)
+        bwt[i + 1] = sa[i] == 0 ? 0 : header.symbolToCode[text[sa[i] - 1]];
+
+    // SA samples: rows whose text position is a multiple of SAMPLE_RATE.
+    uint64_t nWords = bitWords(rows), nBlocks = rankBlocks(rows);
+    uint64_t *marked = (uint64_t *)calloc(nWords, sizeof(uint64_t));
+    uint64_t *markedRank = (uint64_t *)malloc(nBlocks * sizeof(uint64_t));
+    uint32_t *samples = (uint32_t *)malloc((rows / SAMPLE_RATE + 2) * sizeof(uint32_t));
+    for (uint64_t r = 0; r < rows; r++) {
+        uint64_t pos = (r == 0) ? (uint64_t)n : (uint64_t)sa[r - 1];
+        if (pos % SAMPLE_RATE == 0) {
+            marked[r >> 6] |= 1ULL << (r & 63);
+            samples[header.sampleCount++] = (uint32_t)pos;
+        }
+    }
+    buildRankDirectory(marked, rows, markedRank);
+    free(sa);
+
+    // Tree levels: every row appends one bit to each node on its code's
+    // path. Rows go in order, so each node lists its symbols in BWT order.
+    uint64_t *levelWords[MAX_LEVELS], *levelRank[MAX_LEVELS];
+    uint64_t cursor[MAX_SYMBOLS - 1];
+    for (uint64_t l = 0; l < header.levels; l++) {
+        levelWords[l] = (uint64_t *)calloc(bitWords(header.levelLength[l]) + 1, sizeof(uint64_t));
+        levelRank[l] = (uint64_t *)malloc(rankBlocks(header.levelLength[l]) * sizeof(uint64_t));
+        if (levelWords[l] == NULL || levelRank[l] == NULL) {
+            fprintf(stderr, "Memory allocation failed.\n");
+            return -1;
+        }
+    }
+    for (int k = 0; k < internal; k++)
+        cursor[k] = header.nodes[k].start;
+    for (uint64_t r = 0; r < rows; r++) {
+        unsigned int c = bwt[r], length = header.huffmanLength[c];
+        int node = 0;
+        for (unsigned int l = 0; l < length; l++) {
+            int bit = (int)((header.huffmanCode[c] >> (length - 1 - l)) & 1);
+            uint64_t pos = cursor[node]++;
+            if (bit)
+                levelWords[l][pos >> 6] |= 1ULL << (pos & 63);
+            node = header.nodes[node].child[bit];
+        }
+    }
+    free(bwt);
+    for (uint64_t l = 0; l < header.levels; l++)
+        buildRankDirectory(levelWords[l], header.levelLength[l], levelRank[l]);
+    for (int k = 0; k < internal; k++) {
+        int d = nodeDepth[k];
+        BitVector bv = {header.levelLength[d], levelWords[d], levelRank[d]};
+        header.nodes[k].startRank = rank1(&bv, header.nodes[k].start);
+    }
+
+    FILE *out = fopen(path, "wb");
+    if (out == NULL) {
+        perror(path);
+        return -1;
+    }
+    int ok = writeAll(out, &header, sizeof(header));
+    for (uint64_t l = 0; l < header.levels; l++) {
+        ok &= writeAll(out, levelWords[l], bitWords(header.levelLength[l]) * sizeof(uint64_t));
+        ok &= writeAll(out, levelRank[l], rankBlocks(header.levelLength[l]) * sizeof(uint64_t));
+        free(levelWords[l]);
+        free(levelRank[l]);
+    }
+    ok &= writeAll(out, marked, nWords * sizeof(uint64_t));
+    ok &= writeAll(out, markedRank, nBlocks * sizeof(uint64_t));
+    ok &= writeAll(out, samples, header.sampleCount * sizeof(uint32_t));
+    long long size = ftell(out);
+    ok &= fclose(out) == 0;
+
+    free(marked);
+    free(markedRank);
+    free(samples);
+    if (!ok) {
+        fprintf(stderr, "Error writing %s.\n", path);
+        return -1;
+    }
+    return size;
+}
+
+// Points the BitVector at the next words + rank directory in the image.
+static const char *mapBitVector(BitVector *bv, uint64_t length, const char *cursor) {
+    bv->length = length;
+    bv->words = (const uint64_t *)cursor;
+    cursor += align8(bitWords(length) * sizeof(uint64_t));
+    bv->blockRank = (const uint64_t *)cursor;
+    return cursor + align8(rankBlocks(length) * sizeof(uint64_t));
+}
+
+/*
+ * Function: openFMIndex
+ * ---------------------
+ * Memory-maps an index written by buildFMIndex(). No data is copied.
+ * Returns 0 on success, -1 on error.
+ */
+int openFMIndex(const char *path, FMIndex *fm) {
+    int fd = open(path, O_RDONLY);
+    struct stat st;
+    if (fd < 0 || fstat(fd, &st) != 0) {
+        perror(path);
+        return -1;
+    }
+    if ((size_t)st.st_size < sizeof(FMHeader)) {
+        fprintf(stderr, "%s is not an FM-index.\n", path);
+        close(fd);
+        return -1;
+    }
+    fm->mappingSize = (size_t)st.st_size;
+    fm->mapping = mmap(NULL, fm->mappingSize, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (fm->mapping == MAP_FAILED) {
+        perror("mmap");
+        return -1;
+    }
+    fm->header = (const FMHeader *)fm->mapping;
+    if (memcmp(fm->header->magic, FM_MAGIC, 8) != 0 || fm->header->levels > MAX_LEVELS ||
+        fm->header->sigma >= MAX_SYMBOLS) {
+        fprintf(stderr, "%s is not an FM-index.\n", path);
+        munmap(fm->mapping, fm->mappingSize);
+        return -1;
+    }
+    const char *cursor = (const char *)fm->mapping + align8(sizeof(FMHeader));
+    for (uint64_t l = 0; l < fm->header->levels; l++)
+        cursor = mapBitVector(&fm->level[l], fm->header->levelLength[l], cursor);
+    cursor = mapBitVector(&fm->sampled, fm->header->rows, cursor);
+    fm->samples = (const uint32_t *)cursor;
+    cursor += align8(fm->header->sampleCount * sizeof(uint32_t));
+    if (cursor > (const char *)fm->mapping + fm->mappingSize) {
+        fprintf(stderr, "%s is truncated.\n", path);
+        munmap(fm->mapping, fm->mappingSize);
+        return -1;
+    }
+    return 0;
+}
+
+void closeFMIndex(FMIndex *fm) {
+    munmap(fm->mapping, fm->mappingSize);
+}
+
+static int compareU64(const void *a, const void *b) {
+    uint64_t x = *(const uint64_t *)a, y = *(const uint64_t *)b;
+    return (x > y) - (x < y);
+}
+
+#ifndef FM_INDEX_NO_MAIN
+int main(int argc, char *argv[]) {
+    if (argc >= 4 && strcmp(argv[1], "build") == 0) {
+        long length;
+        unsigned char *text = readWholeFile(argv[2], &length);
+        if (text == NULL)
+            return EXIT_FAILURE;
+        if (length >= INT32_MAX) {
+            fprintf(stderr, "Text too large for a 32-bit suffix array.\n");
+            return EXIT_FAILURE;
+        }
+        long long size = buildFMIndex(text, (int)length, argv[3]);
+        free(text);
+        if (size < 0)
+            return EXIT_FAILURE;
+        printf("Indexed %ld bytes into %s: %lld bytes (%.2f bits per text byte)\n",
+               length, argv[3], size, length > 0 ? 8.0 * size / length : 0.0);
+        return EXIT_SUCCESS;
+    }
+
+    if (argc >= 3 && (strcmp(argv[1], "count") == 0 || strcmp(argv[1], "locate") == 0)) {
+        FMIndex fm;
+        if (openFMIndex(argv[2], &fm) != 0)
+            return EXIT_FAILURE;
+        int locate = strcmp(argv[1], "locate") == 0;
+        char pattern[4096];
+        while (fgets(pattern, sizeof(pattern), stdin) != NULL) {
+            pattern[strcspn(pattern, "\n")] = '\0';
+            if (pattern[0] == '\0')
+                continue;
+            uint64_t sp, ep;
+            uint64_t count = fmCount(&fm, pattern, &sp, &ep);
+            printf("Pattern \"%s\": %llu occurrence(s)\n", pattern, (unsigned long long)count);
+            if (locate && count > 0) {
+                uint64_t *positions = (uint64_t *)malloc(count * sizeof(uint64_t));
+                for (uint64_t r = sp; r < ep; r++)
+                    positions[r - sp] = fmLocate(&fm, r);
+                qsort(positions, count, sizeof(uint64_t), compareU64);
+                for (uint64_t k = 0; k < count; k++)
+                    printf("Pattern found at index %llu\n", (unsigned long long)positions[k]);
+                free(positions);
+            }
+        }
+        closeFMIndex(&fm);
+        return EXIT_SUCCESS;
+    }
+
+    fprintf(stderr, "Usage: %s build <text-file> <index-file>\n"
+                    "       %s count <index-file>\n"
+                    "       %s locate <index-file>\n", argv[0], argv[0], argv[0]);
+    return EXIT_FAILURE;
+}
+#endif
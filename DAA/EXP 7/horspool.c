@@ -0,0 +1,82 @@
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+
+#include "string_match.h"
+
+/*
+ * Function: computeShiftTable
+ * ---------------------------
+ * Boyer-Moore-Horspool bad-character table: for every byte c, how far the
+ * window may slide when c is the text byte under the last pattern position.
+ * Bytes absent from pattern[0..m-2] allow a full shift of m.
+ */
+void computeShiftTable(const char *pattern, size_t m, size_t shift[256]) {
+    for (int c = 0; c < 256; c++)
+        shift[c] = m;
+    for (size_t i = 0; i + 1 < m; i++)
+        shift[(unsigned char)pattern[i]] = m - 1 - i;
+}
+
+/*
+ * Function: horspoolScan
+ * ----------------------
+ * Compares the last byte of each window first; on a match the rest is
+ * verified with memcmp. Either way the window slides by the shift of the
+ * text byte under the last pattern position, so with a large alphabet most
+ * text bytes are never read (about n / m comparisons on random text).
+ * Worst case O(n * m).
+ */
+long long horspoolScan(const char *pattern, size_t m, const char *text, size_t n,
+                       MatchCallback report, void *ctx) {
+    long long matches = 0;
+    if (m == 0 || m > n)
+        return 0;
+    size_t shift[256];
+    computeShiftTable(pattern, m, shift);
+
+    const unsigned char last = (unsigned char)pattern[m - 1];
+    size_t i = 0;
+    while (i + m <= n) {
+        unsigned char c = (unsigned char)text[i + m - 1];
+        if (c == last && memcmp(text + i, pattern, m - 1) == 0) {
+            report((long long)i, ctx);
+            matches++;
+        }
+        i += shift[c];
+    }
+    return matches;
+}
+
+// Same output contract as KMP().
+void horspoolSearch(const char *pattern, const char *text) {
+    size_t m = strlen(pattern);
+    size_t n = strlen(text);
+    if (m > n) {
+        printf("No occurrences (pattern is longer than text).\n");
+        return;
+    }
+    horspoolScan(pattern, m, text, n, printMatchIndex, NULL);
+}
+
+#ifndef HORSPOOL_NO_MAIN
+int main() {
+    char text[1000];
+    char pattern[1000];
+
+    printf("Enter the text: ");
+    if (fgets(text, sizeof(text), stdin) == NULL) {
+        fprintf(stderr, "Error reading text.\n");
+        return EXIT_FAILURE;
+    }
+    text[strcspn(text, "\n")] = '\0';
+    printf("Enter the pattern: ");
+    if (fgets(pattern, sizeof(pattern), stdin) == NULL) {
+        fprintf(stderr, "Error reading pattern.\n");
+        return EXIT_FAILURE;
+    }
+    pattern[strcspn(pattern, "\n")] = '\0';
+    horspoolSearch(pattern, text);
+    return EXIT_SUCCESS;
+}
+#endif
@@ -1,18 +1,43 @@
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
+#include <stdint.h>
+
+#include "string_match.h"
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+// Patterns up to this length go to the SIMD filter in searchPattern();
+// longer ones go to KMP(), whose cost does not depend on how often the
+// first/last bytes happen to occur in the text. string_bench.cpp (32 MB,
+// -march=native): on DNA and random bytes the filter is the fastest of
+// the matchers selectMatcher() picks from at every length up to 4096, on
+// English-like text at most lengths. On a^n b every position is a
+// candidate and the filter is the slowest: 0.13-0.20 GB/s, 12-25% of
+// Two-Way, but that factor is about the same at m = 8 as at m = 256,
+// because the memcmp call per candidate costs more than the m / 2 bytes it
+// compares. Past 256 the compares dominate (0.10 GB/s at m = 512, 0.02 at
+// 4096). A limit of 32 would not improve the worst case, and it would give
+// up 4-5x on DNA between 32 and 256.
+#define SIMD_MAX_PATTERN 256
+
 /*
  * Function: computePrefixFunction
  * -------------------------------
  * Computes the prefix function (also known as the failure function) for the KMP algorithm.
  * 
- * pattern: The pattern string for which we compute the prefix function.
- * prefixArray: An integer array of length m (where m = strlen(pattern)) that will store
+ * pattern: The pattern for which we compute the prefix function.
+ * m: The length of the pattern. It is passed explicitly, like every other
+ *    matcher's, so patterns may contain '\0' bytes.
+ * prefixArray: An integer array of length m that will store
  *              the longest proper prefix of the substring pattern[0..i] which is also a suffix
  *              of this substring.
  */
-void computePrefixFunction(const char *pattern, int *prefixArray) {
-    int m = strlen(pattern);
+void computePrefixFunction(const char *pattern, int m, int *prefixArray) {
+    if (m == 0)
+        return;
     int k = 0;              // length of the current longest prefix that is also a suffix
     prefixArray[0] = 0;    
     // We start from i = 1 because prefixArray[0] is already defined
@@ -28,10 +53,119 @@ void computePrefixFunction(const char *pattern, int *prefixArray) {
         prefixArray[i] = k;
     }
 }
+
+/*
+ * Function: kmpScan
+ * -----------------
+ * The KMP matching loop on its own: scans text[0..n) for pattern[0..m)
+ * using a prefix function computed by computePrefixFunction(), reports
+ * every match through 'report' and returns the number of matches.
+ * prefixArray is only read, so several threads may share one, as the
+ * workers of parallel_search.c do.
+ */
+long long kmpScan(const char *pattern, size_t m, const int *prefixArray,
+                  const char *text, size_t n, MatchCallback report, void *ctx) {
+    long long matches = 0;
+    if (m == 0)
+        return 0;
+
+    // 'q' is the number of characters matched so far
+    size_t q = 0;
+
+    // Scan the text from left to right
+    for (size_t i = 0; i < n; i++) {
+        // If next character doesn't match, reduce 'q' using the prefix function
+        while (q > 0 && pattern[q] != text[i]) {
+            q = prefixArray[q - 1];
+        }
+
+        // If next character matches, increment 'q'
+        if (pattern[q] == text[i]) {
+            q++;
+        }
+
+        // If we've matched all characters of the pattern
+        if (q == m) {
+            // Pattern found at index (i - m + 1)
+            report((long long)(i - m + 1), ctx);
+            matches++;
+
+            // Look for the next possible match
+            q = prefixArray[q - 1];
+        }
+    }
+    return matches;
+}
+
+/*
+ * Function: buildKmpDfa
+ * ---------------------
+ * Unrolls the prefix function into the full matching automaton: one row
+ * of 256 transitions for each state q = 0..m (q = characters matched).
+ * Row q copies the row of its failure state prefixArray[q - 1] and then
+ * overrides the single transition that extends the match, so the table
+ * is built in O(256 * m) without any failure-link chasing.
+ *
+ * Entries hold the next state pre-multiplied by 256 (a row offset), which
+ * saves the multiply in the scanning loop. State m is the accepting state;
+ * its row continues after a match exactly as kmpScan() does.
+ *
+ * Returns a malloc'd table of (m + 1) * 256 entries, or NULL on failure
+ * or for an empty pattern.
+ */
+uint32_t *buildKmpDfa(const char *pattern, size_t m, const int *prefixArray) {
+    if (m == 0)
+        return NULL;
+    uint32_t *dfa = (uint32_t *)malloc((m + 1) * 256 * sizeof(uint32_t));
+    if (dfa == NULL) {
+        fprintf(stderr, "Memory allocation failed.\n");
+        return NULL;
+    }
+    memset(dfa, 0, 256 * sizeof(uint32_t));
+    dfa[(unsigned char)pattern[0]] = 1 * 256;
+    for (size_t q = 1; q <= m; q++) {
+        uint32_t *row = &dfa[q * 256];
+        memcpy(row, &dfa[(size_t)prefixArray[q - 1] * 256], 256 * sizeof(uint32_t));
+        if (q < m)
+            row[(unsigned char)pattern[q]] = (uint32_t)(q + 1) * 256;
+    }
+    return dfa;
+}
+
+/*
+ * Function: kmpDfaScan
+ * --------------------
+ * Same contract as kmpScan(), driven by a table from buildKmpDfa(): one
+ * dependent load per text byte and no data-dependent inner loop. The only
+ * branch is the accept test, which is almost never taken and so predicts
+ * well.
+ */
+long long kmpDfaScan(const uint32_t *dfa, size_t m, const char *text, size_t n,
+                     MatchCallback report, void *ctx) {
+    long long matches = 0;
+    if (m == 0)
+        return 0;
+    const uint32_t accept = (uint32_t)m * 256;
+    const unsigned char *s = (const unsigned char *)text;
+    uint32_t q = 0;
+    for (size_t i = 0; i < n; i++) {
+        q = dfa[q + s[i]];
+        if (q == accept) {
+            report((long long)(i + 1 - m), ctx);
+            matches++;
+        }
+    }
+    return matches;
+}
+
 void KMP(const char *pattern, const char *text) {
     int m = strlen(pattern);
     int n = strlen(text);
 
+    if (m == 0) {
+        printf("No occurrences (empty pattern).\n");
+        return;
+    }
     // Edge case: if pattern is longer than text, no match is possible
     if (m > n) {
         printf("No occurrences (pattern is longer than text).\n");
@@ -42,7 +176,7 @@ void KMP(const char *pattern, const char *text) {
         fprintf(stderr, "Memory allocation failed.\n");
         return;
     }
-    computePrefixFunction(pattern, prefixArray);
+    computePrefixFunction(pattern, m, prefixArray);
 
     printf("Prefix Array: ");
     for (int i = 0; i < m; i++) {
@@ -50,33 +184,106 @@ void KMP(const char *pattern, const char *text) {
     }
     printf("\n");
 
-    // 'q' is the number of characters matched so far
-    int q = 0;
+    uint32_t *dfa = buildKmpDfa(pattern, m, prefixArray);
+    if (dfa != NULL)
+        kmpDfaScan(dfa, m, text, n, printMatchIndex, NULL);
+    else
+        kmpScan(pattern, m, prefixArray, text, n, printMatchIndex, NULL);
+    free(dfa);
+    free(prefixArray);
+}
 
-    // Scan the text from left to right
-    for (int i = 0; i < n; i++) {
-        // If next character doesn't match, reduce 'q' using the prefix function
-        while (q > 0 && pattern[q] != text[i]) {
-            q = prefixArray[q - 1];
-        }
+/*
+ * Function: simdScan
+ * ------------------
+ * Vectorised first/last-byte filter. For each block of candidate start
+ * positions i it compares text[i] with pattern[0] and text[i + m - 1] with
+ * pattern[m - 1] for 32 (AVX2) or 16 (SSE2) positions at once; only where
+ * both bytes match are the middle m - 2 bytes verified with memcmp. Falls
+ * back to the same filter one position at a time when no SIMD is available
+ * and for the tail of the text.
+ *
+ * Reports matches through 'report' in increasing order and returns the count.
+ */
+long long simdScan(const char *pattern, size_t m, const char *text, size_t n,
+                   MatchCallback report, void *ctx) {
+    long long matches = 0;
+    if (m == 0 || m > n)
+        return 0;
+    size_t last = m - 1;
+    size_t i = 0;
 
-        // If next character matches, increment 'q'
-        if (pattern[q] == text[i]) {
-            q++;
+#if defined(__AVX2__)
+    const __m256i first32 = _mm256_set1_epi8(pattern[0]);
+    const __m256i last32 = _mm256_set1_epi8(pattern[last]);
+    for (; i + last + 32 <= n; i += 32) {
+        __m256i blockFirst = _mm256_loadu_si256((const __m256i *)(text + i));
+        __m256i blockLast = _mm256_loadu_si256((const __m256i *)(text + i + last));
+        __m256i eq = _mm256_and_si256(_mm256_cmpeq_epi8(first32, blockFirst),
+                                      _mm256_cmpeq_epi8(last32, blockLast));
+        unsigned int mask = (unsigned int)_mm256_movemask_epi8(eq);
+        while (mask != 0) {
+            size_t pos = i + (size_t)__builtin_ctz(mask);
+            if (m <= 2 || memcmp(text + pos + 1, pattern + 1, m - 2) == 0) {
+                report((long long)pos, ctx);
+                matches++;
+            }
+            mask &= mask - 1;
         }
-
-        // If we've matched all characters of the pattern
-        if (q == m) {
-            // Pattern found at index (i - m + 1)
-            printf("Pattern found at index %d\n", i - m + 1);
-
-            // Look for the next possible match
-            q = prefixArray[q - 1];
+    }
+#endif
+#if defined(__SSE2__)
+    const __m128i first16 = _mm_set1_epi8(pattern[0]);
+    const __m128i last16 = _mm_set1_epi8(pattern[last]);
+    for (; i + last + 16 <= n; i += 16) {
+        __m128i blockFirst = _mm_loadu_si128((const __m128i *)(text + i));
+        __m128i blockLast = _mm_loadu_si128((const __m128i *)(text + i + last));
+        __m128i eq = _mm_and_si128(_mm_cmpeq_epi8(first16, blockFirst),
+                                   _mm_cmpeq_epi8(last16, blockLast));
+        unsigned int mask = (unsigned int)_mm_movemask_epi8(eq);
+        while (mask != 0) {
+            size_t pos = i + (size_t)__builtin_ctz(mask);
+            if (m <= 2 || memcmp(text + pos + 1, pattern + 1, m - 2) == 0) {
+                report((long long)pos, ctx);
+                matches++;
+            }
+            mask &= mask - 1;
         }
     }
-    free(prefixArray);
+#endif
+    // Scalar fallback / tail
+    for (; i + last < n; i++) {
+        if (text[i] == pattern[0] && text[i + last] == pattern[last] &&
+            (m <= 2 || memcmp(text + i + 1, pattern + 1, m - 2) == 0)) {
+            report((long long)i, ctx);
+            matches++;
+        }
+    }
+    return matches;
+}
+
+// Same output contract as KMP(): one "Pattern found at index" line per match.
+void simdSearch(const char *pattern, const char *text) {
+    size_t m = strlen(pattern);
+    size_t n = strlen(text);
+    if (m > n) {
+        printf("No occurrences (pattern is longer than text).\n");
+        return;
+    }
+    simdScan(pattern, m, text, n, printMatchIndex, NULL);
+}
+
+// Picks the matcher by pattern length: SIMD filter for short patterns,
+// KMP for long ones.
+void searchPattern(const char *pattern, const char *text) {
+    size_t m = strlen(pattern);
+    if (m > 0 && m <= SIMD_MAX_PATTERN)
+        simdSearch(pattern, text);
+    else
+        KMP(pattern, text);
 }
 
+#ifndef KMP_NO_MAIN
 int main() {
     char text[1000];
     char pattern[1000];
@@ -93,6 +300,7 @@ int main() {
         return EXIT_FAILURE;
     }
     pattern[strcspn(pattern, "\n")] = '\0';
-    KMP(pattern, text);
+    searchPattern(pattern, text);
     return EXIT_SUCCESS;
 }
+#endif
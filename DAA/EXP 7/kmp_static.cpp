@@ -0,0 +1,141 @@
+/*
+ * KMP with the matching automaton built at compile time.
+ *
+ * buildKmpDfa() in kmp.c builds the (m + 1) x 256 transition table at run
+ * time. When the pattern is fixed when the program is built, the same table
+ * can be a constexpr object: the compiler evaluates the construction,
+ * puts the table in .rodata, and compiles the scan loop with the pattern
+ * length (and therefore the accepting state) as a constant.
+ *
+ * The pattern is KMP_STATIC_PATTERN; override it at build time, e.g.
+ *   g++ -std=c++17 -O2 -DKMP_STATIC_PATTERN='"GATTACA"' -o kmp_static kmp_static.cpp
+ *
+ * Usage: ./kmp_static [text-file]   (text from stdin if no file)
+ * Compile with: g++ -std=c++17 -O2 -o kmp_static kmp_static.cpp
+ */
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+using namespace std;
+
+#ifndef KMP_STATIC_PATTERN
+#define KMP_STATIC_PATTERN "ABABCABAB"
+#endif
+
+/*
+ * Transition table for a pattern of length M. Same layout as
+ * buildKmpDfa(): row q holds the 256 successors of state q, stored as
+ * row offsets (state * 256). States fit in 16 bits while the accepting
+ * row offset M * 256 plus a byte does, i.e. for M <= 254, which halves
+ * the table for the short patterns this path is meant for.
+ */
+template <size_t M>
+struct StaticKmpDfa {
+    static_assert(M > 0, "pattern must not be empty");
+    using State = typename conditional<(M + 1) * 256 <= 0xFFFF, uint16_t, uint32_t>::type;
+    static constexpr State accept = State(M * 256);
+
+    array<State, (M + 1) * 256> next{};
+
+    constexpr explicit StaticKmpDfa(const char (&pattern)[M + 1]) {
+        // Prefix function, as computePrefixFunction() in kmp.c
+        array<size_t, M> prefix{};
+        size_t k = 0;
+        for (size_t i = 1; i < M; i++) {
+            while (k > 0 && pattern[k] != pattern[i])
+                k = prefix[k - 1];
+            if (pattern[k] == pattern[i])
+                k++;
+            prefix[i] = k;
+        }
+        // Row q = row of its failure state, plus the transition that extends the match
+        next[static_cast<unsigned char>(pattern[0])] = State(256);
+        for (size_t q = 1; q <= M; q++) {
+            for (size_t c = 0; c < 256; c++)
+                next[q * 256 + c] = next[prefix[q - 1] * 256 + c];
+            if (q < M)
+                next[q * 256 + static_cast<unsigned char>(pattern[q])] = State((q + 1) * 256);
+        }
+    }
+
+    // Runs the automaton over text[0..n) and calls report(offset) for each
+    // match start. One table load per byte; the loop is unrolled by 4.
+    template <typename Report>
+    long long scan(const char *text, size_t n, Report &&report) const {
+        const unsigned char *s = reinterpret_cast<const unsigned char *>(text);
+        long long matches = 0;
+        State q = 0;
+        size_t i = 0;
+        auto step = [&](size_t j) {
+            q = next[q + s[j]];
+            if (q == accept) {
+                report(static_cast<long long>(j + 1 - M));
+                matches++;
+            }
+        };
+        for (; i + 4 <= n; i += 4) {
+            step(i);
+            step(i + 1);
+            step(i + 2);
+            step(i + 3);
+        }
+        for (; i < n; i++)
+            step(i);
+        return matches;
+    }
+
+    // Whole-string match count, usable in constant expressions.
+    constexpr size_t count(const char *text, size_t n) const {
+        size_t found = 0;
+        size_t q = 0;
+        for (size_t i = 0; i < n; i++) {
+            q = next[q + static_cast<unsigned char>(text[i])];
+            found += (q == accept);
+        }
+        return found;
+    }
+};
+
+template <size_t N>
+constexpr StaticKmpDfa<N - 1> makeKmpDfa(const char (&pattern)[N]) {
+    return StaticKmpDfa<N - 1>(pattern);
+}
+
+static constexpr char staticPattern[] = KMP_STATIC_PATTERN;
+static constexpr auto staticDfa = makeKmpDfa(staticPattern);
+
+// The table really is built by the compiler: the pattern must find itself.
+// (An empty pattern already fails the static_assert in StaticKmpDfa.)
+static_assert(sizeof(staticPattern) == 1 ||
+                  staticDfa.count(staticPattern, sizeof(staticPattern) - 1) == 1,
+              "compile-time KMP automaton does not accept its own pattern");
+
+int main(int argc, char *argv[]) {
+    string text;
+    if (argc > 1) {
+        ifstream in(argv[1], ios::binary);
+        if (!in) {
+            perror(argv[1]);
+            return 1;
+        }
+        text.assign(istreambuf_iterator<char>(in), istreambuf_iterator<char>());
+    } else {
+        cout << "Enter the text: ";
+        if (!getline(cin, text)) {
+            cerr << "Error reading text." << endl;
+            return 1;
+        }
+    }
+
+    cout << "Pattern (fixed at compile time): " << staticPattern << "\n";
+    long long matches = staticDfa.scan(text.data(), text.size(), [](long long offset) {
+        cout << "Pattern found at index " << offset << "\n";
+    });
+    cout << "Matches: " << matches << "\n";
+    return 0;
+}
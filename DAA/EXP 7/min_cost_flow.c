@@ -0,0 +1,381 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+
+#include "flow_stats.h"
+
+/*
+ * Min-cost max-flow by successive shortest paths.
+ *
+ * Same residual-network idea as Edmond_Karp.c, but every edge also carries
+ * a cost and the augmenting path chosen is the cheapest one instead of the
+ * shortest one. The residual graph is an adjacency list (edge i and its
+ * reverse are stored as the pair i, i^1) so it scales to ~10^5 vertices,
+ * where a MAX x MAX matrix would not fit.
+ *
+ * Each iteration runs Dijkstra on reduced costs
+ *     c_p(u,v) = cost(u,v) + potential[u] - potential[v]
+ * which are non-negative once the potentials are shortest-path distances
+ * (Johnson's trick). After the search, potential[v] += dist[v] keeps that
+ * invariant for the next iteration, so Bellman-Ford is needed at most once,
+ * up front, and only if the input has negative edge costs.
+ */
+
+#define INF_COST LLONG_MAX
+
+typedef struct {
+    int to;          // head of the edge
+    int next;        // next edge out of the same tail (-1 ends the list)
+    long long cap;   // residual capacity
+    long long cost;  // cost per unit of flow
+} CostEdge;
+
+typedef struct {
+    int n;
+    int edgeCount, edgeCapacity;
+    int *head;       // head[u] = first edge out of u, -1 if none
+    CostEdge *edges;
+} CostNetwork;
+
+typedef struct {
+    long long flow;
+    long long cost;
+} FlowResult;
+
+FlowStats mcfStats;  // counters for the most recent minCostMaxFlow() call
+
+CostNetwork *createCostNetwork(int n) {
+    CostNetwork *net = (CostNetwork *)malloc(sizeof(CostNetwork));
+    net->n = n;
+    net->edgeCount = 0;
+    net->edgeCapacity = 16;
+    net->head = (int *)malloc(n * sizeof(int));
+    net->edges = (CostEdge *)malloc(net->edgeCapacity * sizeof(CostEdge));
+    if (net->head == NULL || net->edges == NULL) {
+        fprintf(stderr, "Memory allocation failed.\n");
+        exit(EXIT_FAILURE);
+    }
+    memset(net->head, -1, n * sizeof(int));
+    return net;
+}
+
+void freeCostNetwork(CostNetwork *net) {
+    free(net->head);
+    free(net->edges);
+    free(net);
+}
+
+static void pushCostEdge(CostNetwork *net, int u, int v, long long cap, long long cost) {
+    if (net->edgeCount == net->edgeCapacity) {
+        net->edgeCapacity *= 2;
+        net->edges = (CostEdge *)realloc(net->edges, net->edgeCapacity * sizeof(CostEdge));
+        if (net->edges == NULL) {
+            fprintf(stderr, "Memory allocation failed.\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+    CostEdge *e = &net->edges[net->edgeCount];
+    e->to = v;
+    e->cap = cap;
+    e->cost = cost;
+    e->next = net->head[u];
+    net->head[u] = net->edgeCount++;
+}
+
+// Adds u->v with the given capacity and cost, plus its zero-capacity
+// reverse edge v->u with cost -cost. Returns the index of the forward edge;
+// the flow on it is later edges[i^1].cap.
+int addCostEdge(CostNetwork *net, int u, int v, long long cap, long long cost) {
+    int id = net->edgeCount;
+    pushCostEdge(net, u, v, cap, cost);
+    pushCostEdge(net, v, u, 0, -cost);
+    return id;
+}
+
+// -------------------------- Min-Heap on (dist, vertex) --------------------------
+// Lazy-deletion binary heap: a vertex may appear several times and stale
+// entries are skipped when popped. The array grows on demand.
+typedef struct {
+    long long dist;
+    int vertex;
+} CostHeapNode;
+
+typedef struct {
+    CostHeapNode *array;
+    int size, capacity;
+} CostHeap;
+
+static void costHeapPush(CostHeap *heap, long long dist, int vertex) {
+    if (heap->size == heap->capacity) {
+        heap->capacity = heap->capacity ? 2 * heap->capacity : 64;
+        heap->array = (CostHeapNode *)realloc(heap->array, heap->capacity * sizeof(CostHeapNode));
+        if (heap->array == NULL) {
+            fprintf(stderr, "Memory allocation failed.\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+    int idx = heap->size++;
+    while (idx > 0) {
+        int parent = (idx - 1) / 2;
+        if (heap->array[parent].dist <= dist)
+            break;
+        heap->array[idx] = heap->array[parent];
+        idx = parent;
+    }
+    heap->array[idx].dist = dist;
+    heap->array[idx].vertex = vertex;
+}
+
+static CostHeapNode costHeapPop(CostHeap *heap) {
+    CostHeapNode top = heap->array[0];
+    CostHeapNode last = heap->array[--heap->size];
+    int idx = 0;
+    while (1) {
+        int child = 2 * idx + 1;
+        if (child >= heap->size)
+            break;
+        if (child + 1 < heap->size && heap->array[child + 1].dist < heap->array[child].dist)
+            child++;
+        if (last.dist <= heap->array[child].dist)
+            break;
+        heap->array[idx] = heap->array[child];
+        idx = child;
+    }
+    if (heap->size > 0)
+        heap->array[idx] = last;
+    return top;
+}
+
+// -------------------------- Initial potentials --------------------------
+// Queue-based Bellman-Ford over edges with residual capacity. Only used when
+// some edge has a negative cost. Returns 0 if a negative cycle is reachable:
+// pathEdges[v] counts the edges on the walk that gave v its label, and a
+// walk of n edges repeats a vertex with a lower label, i.e. closes a
+// negative cycle. (How often a label drops says nothing about cycles.)
+static int initialPotentials(const CostNetwork *net, int s, long long *potential) {
+    int n = net->n;
+    int *queue = (int *)malloc(n * sizeof(int));
+    char *inQueue = (char *)calloc(n, 1);
+    int *pathEdges = (int *)malloc(n * sizeof(int));
+    int front = 0, size = 0, ok = 1;
+
+    for (int v = 0; v < n; v++)
+        potential[v] = INF_COST;
+    potential[s] = 0;
+    pathEdges[s] = 0;
+    queue[0] = s;
+    size = 1;
+    inQueue[s] = 1;
+
+    while (size > 0 && ok) {
+        int u = queue[front];
+        front = (front + 1) % n;
+        size--;
+        inQueue[u] = 0;
+        for (int i = net->head[u]; i != -1; i = net->edges[i].next) {
+            const CostEdge *e = &net->edges[i];
+            if (e->cap > 0 && potential[u] + e->cost < potential[e->to]) {
+                potential[e->to] = potential[u] + e->cost;
+                pathEdges[e->to] = pathEdges[u] + 1;
+                if (pathEdges[e->to] >= n) {
+                    ok = 0;
+                    break;
+                }
+                if (!inQueue[e->to]) {
+                    queue[(front + size) % n] = e->to;
+                    size++;
+                    inQueue[e->to] = 1;
+                }
+            }
+        }
+    }
+    // Unreachable vertices never lie on an augmenting path; any finite
+    // potential works for them.
+    for (int v = 0; v < n; v++) {
+        if (potential[v] == INF_COST)
+            potential[v] = 0;
+    }
+    free(queue);
+    free(inQueue);
+    free(pathEdges);
+    return ok;
+}
+
+/*
+ * Function: minCostMaxFlow
+ * ------------------------
+ * Sends the maximum flow from s to t at minimum total cost. s == t gives
+ * an empty flow.
+ * Sets *ok to 0 (and returns what was computed so far) if the network
+ * contains a negative-cost cycle reachable from s.
+ */
+FlowResult minCostMaxFlow(CostNetwork *net, int s, int t, int *ok) {
+    int n = net->n;
+    FlowResult result = {0, 0};
+    long long *potential = (long long *)malloc(n * sizeof(long long));
+    long long *dist = (long long *)malloc(n * sizeof(long long));
+    int *parentEdge = (int *)malloc(n * sizeof(int));
+    CostHeap heap = {NULL, 0, 0};
+
+    memset(&mcfStats, 0, sizeof(mcfStats));
+    clock_t phase = clock();
+    *ok = 1;
+    if (s == t) {
+        free(potential);
+        free(dist);
+        free(parentEdge);
+        return result;
+    }
+
+    int hasNegative = 0;
+    for (int i = 0; i < net->edgeCount; i += 2) {
+        if (net->edges[i].cost < 0 && net->edges[i].cap > 0)
+            hasNegative = 1;
+    }
+    if (hasNegative) {
+        *ok = initialPotentials(net, s, potential);
+    } else {
+        memset(potential, 0, n * sizeof(long long));
+    }
+    mcfStats.initTime = elapsedSeconds(phase);
+
+    while (*ok) {
+        // Dijkstra on reduced costs
+        phase = clock();
+        for (int v = 0; v < n; v++) {
+            dist[v] = INF_COST;
+            parentEdge[v] = -1;
+        }
+        dist[s] = 0;
+        heap.size = 0;
+        costHeapPush(&heap, 0, s);
+        while (heap.size > 0) {
+            CostHeapNode top = costHeapPop(&heap);
+            int u = top.vertex;
+            if (top.dist != dist[u])
+                continue;  // stale entry
+            for (int i = net->head[u]; i != -1; i = net->edges[i].next) {
+                const CostEdge *e = &net->edges[i];
+                mcfStats.edgesScanned++;
+                if (e->cap <= 0)
+                    continue;
+                long long nd = dist[u] + e->cost + potential[u] - potential[e->to];
+                if (nd < dist[e->to]) {
+                    dist[e->to] = nd;
+                    parentEdge[e->to] = i;
+                    costHeapPush(&heap, nd, e->to);
+                }
+            }
+        }
+        mcfStats.searchTime += elapsedSeconds(phase);
+        if (dist[t] == INF_COST)
+            break;
+
+        phase = clock();
+        mcfStats.augmentations++;
+        for (int v = 0; v < n; v++) {
+            if (dist[v] != INF_COST)
+                potential[v] += dist[v];
+        }
+
+        // Bottleneck along the path (walk back via the paired reverse edges)
+        long long pathFlow = LLONG_MAX;
+        for (int v = t; v != s; v = net->edges[parentEdge[v] ^ 1].to) {
+            if (net->edges[parentEdge[v]].cap < pathFlow)
+                pathFlow = net->edges[parentEdge[v]].cap;
+        }
+        // potential[t] - potential[s] is now the true cost of one unit
+        long long unitCost = potential[t] - potential[s];
+
+#if TRACE
+        printf("\nIteration %ld:\n", mcfStats.augmentations);
+        printf("Augmenting path (sink -> source): ");
+        for (int v = t; v != s; v = net->edges[parentEdge[v] ^ 1].to)
+            printf("%d <- ", v);
+        printf("%d\n", s);
+        printf("Bottleneck capacity = %lld, cost per unit = %lld\n", pathFlow, unitCost);
+#endif
+
+        for (int v = t; v != s; v = net->edges[parentEdge[v] ^ 1].to) {
+            net->edges[parentEdge[v]].cap -= pathFlow;
+            net->edges[parentEdge[v] ^ 1].cap += pathFlow;
+            mcfStats.residualUpdates += 2;
+        }
+        result.flow += pathFlow;
+        result.cost += pathFlow * unitCost;
+        mcfStats.augmentTime += elapsedSeconds(phase);
+    }
+
+    free(potential);
+    free(dist);
+    free(parentEdge);
+    free(heap.array);
+    return result;
+}
+
+#ifndef MIN_COST_FLOW_NO_MAIN
+int main() {
+    int n, m;
+    printf("Enter the number of vertices: ");
+    if (scanf("%d", &n) != 1 || n <= 0) {
+        fprintf(stderr, "Invalid number of vertices.\n");
+        return EXIT_FAILURE;
+    }
+    printf("Enter the number of edges: ");
+    if (scanf("%d", &m) != 1 || m < 0) {
+        fprintf(stderr, "Invalid number of edges.\n");
+        return EXIT_FAILURE;
+    }
+
+    CostNetwork *net = createCostNetwork(n);
+    int *edgeIds = (int *)malloc((m > 0 ? m : 1) * sizeof(int));
+    printf("Enter edges in format (u v capacity cost):\n");
+    for (int i = 0; i < m; i++) {
+        int u, v;
+        long long cap, cost;
+        if (scanf("%d %d %lld %lld", &u, &v, &cap, &cost) != 4 ||
+            u < 0 || u >= n || v < 0 || v >= n || cap < 0) {
+            fprintf(stderr, "Invalid edge %d.\n", i);
+            return EXIT_FAILURE;
+        }
+        edgeIds[i] = addCostEdge(net, u, v, cap, cost);
+    }
+
+    int source, sink;
+    printf("Enter source: ");
+    if (scanf("%d", &source) != 1 || source < 0 || source >= n) {
+        fprintf(stderr, "Invalid source.\n");
+        return EXIT_FAILURE;
+    }
+    printf("Enter sink: ");
+    if (scanf("%d", &sink) != 1 || sink < 0 || sink >= n || sink == source) {
+        fprintf(stderr, "Invalid sink (must differ from the source).\n");
+        return EXIT_FAILURE;
+    }
+
+    int ok;
+    FlowResult result = minCostMaxFlow(net, source, sink, &ok);
+    if (!ok) {
+        printf("A negative-cost cycle is reachable from the source; min cost is unbounded.\n");
+    } else {
+        printf("\nMaximum Flow = %lld, Minimum Cost = %lld\n", result.flow, result.cost);
+#if FLOW_REPORT
+        printf("\nFlow on edges carrying flow:\n");
+        for (int i = 0; i < m; i++) {
+            const CostEdge *e = &net->edges[edgeIds[i]];
+            long long f = net->edges[edgeIds[i] ^ 1].cap;
+            if (f > 0) {
+                printf("  Edge (%d -> %d): flow = %lld / capacity = %lld, cost = %lld\n",
+                       net->edges[edgeIds[i] ^ 1].to, e->to, f, e->cap + f, e->cost);
+            }
+        }
+#endif
+    }
+    printFlowStats("Min-cost SSP", &mcfStats);
+
+    free(edgeIds);
+    freeCostNetwork(net);
+    return 0;
+}
+#endif
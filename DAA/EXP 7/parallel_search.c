@@ -0,0 +1,231 @@
+/*
+ * Parallel single-pattern search.
+ *
+ * The text (a memory-mapped file) is split into T contiguous ranges of
+ * candidate start positions, one per thread. Thread k owns starts in
+ * [begin_k, end_k) and scans text[begin_k, end_k + m - 1), i.e. its range
+ * plus an m - 1 byte overlap into the next one, so a match that straddles
+ * the split is seen by exactly the thread that owns its start. Each
+ * thread collects its offsets in order; concatenating the per-thread
+ * lists in thread order therefore gives all matches sorted and without
+ * duplicates.
+ *
+ * The matcher is any of the scanners in this directory, picked by name or
+ * by selectMatcher() (string_search.c); they all share the MatchCallback
+ * contract. It is prepared once (for KMP: the prefix function and DFA) and
+ * the threads share that state read-only.
+ *
+ * Usage: ./parallel_search [auto|kmp|simd|horspool|twoway|rk] <pattern> <file>
+ *                          [--threads N] [--count]
+ * Compile with: gcc -O2 -pthread -o parallel_search parallel_search.c
+ */
+
+#define STRING_SEARCH_NO_MAIN
+#include "string_search.c"
+
+#include <pthread.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+typedef struct {
+    long long *offsets;
+    size_t count, capacity;
+} OffsetList;
+
+static void appendOffset(long long offset, void *ctx) {
+    OffsetList *list = (OffsetList *)ctx;
+    if (list->count == list->capacity) {
+        list->capacity = list->capacity ? 2 * list->capacity : 1024;
+        list->offsets = (long long *)realloc(list->offsets, list->capacity * sizeof(long long));
+        if (list->offsets == NULL) {
+            fprintf(stderr, "Memory allocation failed.\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+    list->offsets[list->count++] = offset;
+}
+
+static void countOffset(long long offset, void *ctx) {
+    (void)offset;
+    (*(size_t *)ctx)++;
+}
+
+typedef struct {
+    const PreparedMatcher *matcher;   // shared by all threads, read-only
+    size_t m;
+    const char *text;
+    size_t n;
+    size_t begin, end;        // candidate start positions owned by this thread
+    int countOnly;
+    OffsetList matches;       // offsets relative to the whole text
+    size_t matchCount;
+} SearchTask;
+
+// Adds the range base back onto offsets reported relative to the slice.
+static void reportInSlice(long long offset, void *ctx) {
+    SearchTask *task = (SearchTask *)ctx;
+    if (task->countOnly)
+        countOffset(offset, &task->matchCount);
+    else
+        appendOffset((long long)task->begin + offset, &task->matches);
+}
+
+static void *searchWorker(void *arg) {
+    SearchTask *task = (SearchTask *)arg;
+    if (task->begin >= task->end)
+        return NULL;
+    // Scan the owned range plus m - 1 bytes of overlap (clipped to the text).
+    size_t sliceEnd = task->end + task->m - 1;
+    if (sliceEnd > task->n)
+        sliceEnd = task->n;
+    const char *slice = task->text + task->begin;
+    size_t sliceLength = sliceEnd - task->begin;
+
+    scanMatcher(task->matcher, slice, sliceLength, reportInSlice, task);
+    if (!task->countOnly)
+        task->matchCount = task->matches.count;
+    return NULL;
+}
+
+/*
+ * Function: parallelSearch
+ * ------------------------
+ * Runs 'kind' over text[0..n) on 'threads' threads. Fills *result with all
+ * match offsets in increasing order (unless countOnly) and returns the
+ * number of matches.
+ */
+size_t parallelSearch(MatcherKind kind, const char *pattern, const char *text, size_t n,
+                      int threads, int countOnly, OffsetList *result) {
+    size_t m = strlen(pattern);
+    result->offsets = NULL;
+    result->count = result->capacity = 0;
+    if (m == 0 || m > n)
+        return 0;
+
+    size_t starts = n - m + 1;  // number of candidate start positions
+    if ((size_t)threads > starts)
+        threads = (int)starts;
+    PreparedMatcher matcher;
+    if (prepareMatcher(&matcher, kind, pattern, m) != 0)
+        return 0;
+    SearchTask *tasks = (SearchTask *)calloc(threads, sizeof(SearchTask));
+    pthread_t *ids = (pthread_t *)malloc(threads * sizeof(pthread_t));
+    int *started = (int *)calloc(threads, sizeof(int));
+    if (tasks == NULL || ids == NULL || started == NULL) {
+        fprintf(stderr, "Memory allocation failed.\n");
+        free(tasks);
+        free(ids);
+        free(started);
+        freePreparedMatcher(&matcher);
+        return 0;
+    }
+
+    for (int k = 0; k < threads; k++) {
+        SearchTask *task = &tasks[k];
+        task->matcher = &matcher;
+        task->m = m;
+        task->text = text;
+        task->n = n;
+        task->begin = starts / threads * k + ((size_t)k < starts % threads ? (size_t)k : starts % threads);
+        task->end = task->begin + starts / threads + ((size_t)k < starts % threads ? 1 : 0);
+        task->countOnly = countOnly;
+        // Without a thread the slice is searched on this one instead.
+        started[k] = pthread_create(&ids[k], NULL, searchWorker, task) == 0;
+        if (!started[k])
+            searchWorker(task);
+    }
+
+    size_t total = 0;
+    for (int k = 0; k < threads; k++) {
+        if (started[k])
+            pthread_join(ids[k], NULL);
+        total += tasks[k].matchCount;
+    }
+    // Merge: ranges are disjoint and in order, so concatenation is sorted.
+    if (!countOnly && total > 0) {
+        result->offsets = (long long *)malloc(total * sizeof(long long));
+        if (result->offsets == NULL)
+            fprintf(stderr, "Memory allocation failed.\n");
+        else
+            result->capacity = total;
+        for (int k = 0; k < threads; k++) {
+            if (result->offsets != NULL && tasks[k].matches.count > 0)
+                memcpy(result->offsets + result->count, tasks[k].matches.offsets,
+                       tasks[k].matches.count * sizeof(long long));
+            if (result->offsets != NULL)
+                result->count += tasks[k].matches.count;
+            free(tasks[k].matches.offsets);
+        }
+    }
+    free(tasks);
+    free(ids);
+    free(started);
+    freePreparedMatcher(&matcher);
+    return total;
+}
+
+#ifndef PARALLEL_SEARCH_NO_MAIN
+int main(int argc, char *argv[]) {
+    if (argc < 4) {
+        fprintf(stderr, "Usage: %s [auto|kmp|simd|horspool|twoway|rk] <pattern> <file>"
+                        " [--threads N] [--count]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+    const char *pattern = argv[2];
+    MatcherKind kind;
+    if (strcmp(argv[1], "auto") == 0) {
+        kind = selectMatcher(pattern, strlen(pattern));
+    } else if (parseMatcher(argv[1], &kind) != 0) {
+        fprintf(stderr, "Unknown matcher '%s'.\n", argv[1]);
+        return EXIT_FAILURE;
+    }
+    const char *path = argv[3];
+    int threads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    int countOnly = 0;
+    for (int i = 4; i < argc; i++) {
+        if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc)
+            threads = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--count") == 0)
+            countOnly = 1;
+    }
+    if (threads < 1)
+        threads = 1;
+
+    int fd = open(path, O_RDONLY);
+    struct stat st;
+    if (fd < 0 || fstat(fd, &st) != 0) {
+        perror(path);
+        return EXIT_FAILURE;
+    }
+    size_t n = (size_t)st.st_size;
+    const char *text = "";
+    if (n > 0) {
+        text = (const char *)mmap(NULL, n, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (text == MAP_FAILED) {
+            perror("mmap");
+            return EXIT_FAILURE;
+        }
+    }
+
+    struct timespec t0, t1;
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    OffsetList result;
+    size_t total = parallelSearch(kind, pattern, text, n, threads, countOnly, &result);
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    double seconds = (t1.tv_sec - t0.tv_sec) + (t1.tv_nsec - t0.tv_nsec) * 1e-9;
+
+    for (size_t i = 0; i < result.count; i++)
+        printf("Pattern found at index %lld\n", result.offsets[i]);
+    printf("Total matches: %zu (%s, %d threads, %.3f s, %.2f GB/s)\n", total, matcherName(kind),
+           threads, seconds,
+           seconds > 0 ? n / seconds / 1e9 : 0.0);
+
+    free(result.offsets);
+    if (n > 0)
+        munmap((void *)text, n);
+    close(fd);
+    return EXIT_SUCCESS;
+}
+#endif
@@ -1,58 +1,387 @@
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
+#include <stdint.h>
+#include <time.h>
+#include <pthread.h>
 
-#define RADIX 10
-#define PRIME 101   // A prime number used for modulo operations
+#include "string_match.h"
 
-void rabinKarpSearch(const char *pattern, const char *text) {
-    int m = strlen(pattern);   
-    int n = strlen(text);      
-    int i, j;
-    int patternHash = 0;       // Hash value for the pattern
-    int textHash = 0;          // Hash value for the current window of text
-    int h = 1;                 // The value of RADIX^(m-1) modulo PRIME
+/*
+ * Rolling hash: polynomial hash modulo the Mersenne prime 2^61 - 1 with a
+ * random base chosen at start-up.
+ *
+ * With RADIX 10 / PRIME 101 about 1 window in 101 collided with the pattern
+ * hash and had to be verified character by character. With a 61-bit prime
+ * and a random base, two different windows collide with probability at most
+ * m / 2^61, so every hash hit is (in practice) a real match.
+ *
+ * Arithmetic is on unsigned 64-bit values: removing the leading byte adds a
+ * precomputed (MOD - c * h) instead of subtracting, so no negative-modulo
+ * fixups are needed.
+ */
+#define HASH_MOD ((1ULL << 61) - 1)
 
-    // Precompute h = RADIX^(m-1) % PRIME.
-    // This value is used to remove the leading digit in the rolling hash.
-    for (i = 0; i < m - 1; i++) {
-        h = (h * RADIX) % PRIME;
-    }
+typedef struct {
+    uint64_t base;              // random base in [256, HASH_MOD - 1]
+    uint64_t h;                 // base^(m-1) % HASH_MOD
+    uint64_t removeTerm[256];   // (HASH_MOD - c * h % HASH_MOD) for every byte c
+} RollingHash;
+
+// Counters for the most recent search: how many windows hit the pattern
+// hash versus how many of those were real matches after verification.
+// Kept per thread so parallel_search.c can run scans concurrently.
+typedef struct {
+    long long windows;
+    long long hashHits;
+    long long verifiedMatches;
+    long long spuriousHits;     // hash hits that matched no pattern
+} RabinKarpStats;
+
+__thread RabinKarpStats rkStats;
+
+static uint64_t reduceMod61(uint64_t x) {
+    x = (x & HASH_MOD) + (x >> 61);
+    return (x >= HASH_MOD) ? x - HASH_MOD : x;
+}
+
+static uint64_t mulMod61(uint64_t a, uint64_t b) {
+    unsigned __int128 product = (unsigned __int128)a * b;
+    uint64_t lo = (uint64_t)product & HASH_MOD;
+    uint64_t hi = (uint64_t)(product >> 61);
+    return reduceMod61(lo + hi);
+}
+
+// Appends byte c to a hash: hash * base + c.
+static uint64_t hashPush(const RollingHash *rh, uint64_t hash, unsigned char c) {
+    return reduceMod61(mulMod61(hash, rh->base) + c);
+}
+
+// Slides the window: drops 'out' from the front, appends 'in' at the back.
+static uint64_t hashRoll(const RollingHash *rh, uint64_t hash, unsigned char out, unsigned char in) {
+    // hash < 2^61 and removeTerm < 2^61, so the sum cannot overflow.
+    return reduceMod61(mulMod61(hash + rh->removeTerm[out], rh->base) + in);
+}
+
+static uint64_t randomBase(void) {
+    uint64_t seed = 0;
+    FILE *urandom = fopen("/dev/urandom", "rb");
+    if (urandom == NULL || fread(&seed, sizeof(seed), 1, urandom) != 1)
+        seed = (uint64_t)time(NULL) ^ ((uint64_t)clock() << 32) ^ (uint64_t)(uintptr_t)&seed;
+    if (urandom != NULL)
+        fclose(urandom);
+    // splitmix64 finaliser spreads a weak seed over all bits
+    seed += 0x9E3779B97F4A7C15ULL;
+    seed = (seed ^ (seed >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    seed = (seed ^ (seed >> 27)) * 0x94D049BB133111EBULL;
+    seed ^= seed >> 31;
+    return 256 + seed % (HASH_MOD - 256);
+}
+
+static uint64_t sharedBase;
+static pthread_once_t sharedBaseOnce = PTHREAD_ONCE_INIT;
+
+static void drawSharedBase(void) {
+    sharedBase = randomBase();
+}
+
+// Prepares the hash for windows of length m. The base is drawn once per
+// process so every pattern and text in one run share the same hash;
+// pthread_once makes that safe when scans start on several threads.
+void initRollingHash(RollingHash *rh, int m) {
+    pthread_once(&sharedBaseOnce, drawSharedBase);
+    uint64_t base = sharedBase;
+    rh->base = base;
+    rh->h = 1;
+    for (int i = 0; i < m - 1; i++)
+        rh->h = mulMod61(rh->h, base);
+    for (int c = 0; c < 256; c++)
+        rh->removeTerm[c] = HASH_MOD - mulMod61((uint64_t)c, rh->h);
+}
+
+/*
+ * Function: rabinKarpScan
+ * -----------------------
+ * Reports every occurrence of pattern[0..m) in text[0..n) through 'report',
+ * in increasing order, and returns the number of matches. Updates rkStats.
+ */
+long long rabinKarpScan(const char *pattern, size_t m, const char *text, size_t n,
+                        MatchCallback report, void *ctx) {
+    memset(&rkStats, 0, sizeof(rkStats));
+    if (m == 0 || m > n)
+        return 0;
+
+    const unsigned char *p = (const unsigned char *)pattern;
+    const unsigned char *t = (const unsigned char *)text;
+    RollingHash rh;
+    initRollingHash(&rh, (int)m);
 
     // Calculate the initial hash values for the pattern and the first window of text.
-    for (i = 0; i < m; i++) {
-        patternHash = (RADIX * patternHash + pattern[i]) % PRIME;
-        textHash = (RADIX * textHash + text[i]) % PRIME;
+    uint64_t patternHash = 0, textHash = 0;
+    for (size_t i = 0; i < m; i++) {
+        patternHash = hashPush(&rh, patternHash, p[i]);
+        textHash = hashPush(&rh, textHash, t[i]);
     }
 
     // Slide the pattern over text one by one.
-    for (i = 0; i <= n - m; i++) {
-        // If the hash values match, then only check the characters one by one.
+    for (size_t i = 0; i + m <= n; i++) {
+        // If the hash values match, verify to rule out a spurious hit.
         if (patternHash == textHash) {
-            /* Check for spurious hit by comparing the actual characters */
-            for (j = 0; j < m; j++) {
-                if (text[i + j] != pattern[j])
-                    break;
+            rkStats.hashHits++;
+            if (memcmp(text + i, pattern, m) == 0) {
+                rkStats.verifiedMatches++;
+                report((long long)i, ctx);
+            } else {
+                rkStats.spuriousHits++;
             }
-            // If the pattern is found, print the shift (i.e., starting index).
-            if (j == m) {
-                printf("Pattern found at index %d\n", i);
+        }
+        // Remove the leading byte and add the trailing byte.
+        if (i + m < n)
+            textHash = hashRoll(&rh, textHash, t[i], t[i + m]);
+    }
+    rkStats.windows = (long long)(n - m + 1);
+    return rkStats.verifiedMatches;
+}
+
+void rabinKarpSearch(const char *pattern, const char *text) {
+    rabinKarpScan(pattern, strlen(pattern), text, strlen(text), printMatchIndex, NULL);
+}
+
+// -------------------------- Pattern-set search --------------------------
+// Open-addressing (linear probing) table from pattern hash to the patterns
+// with that hash. Patterns with equal hashes (duplicates, or a true 2^-61
+// collision) are chained through nextSameHash[].
+typedef struct {
+    uint64_t *slotHash;
+    int *slotPattern;      // first pattern id in the slot, -1 = empty
+    int *nextSameHash;     // per pattern id, -1 ends the chain
+    size_t mask;           // table size - 1 (size is a power of two)
+} PatternHashSet;
+
+static void buildPatternHashSet(PatternHashSet *set, const RollingHash *rh,
+                                const char *const *patterns, int count, size_t m) {
+    size_t size = 16;
+    while (size < 2 * (size_t)count)
+        size <<= 1;
+    set->mask = size - 1;
+    set->slotHash = (uint64_t *)malloc(size * sizeof(uint64_t));
+    set->slotPattern = (int *)malloc(size * sizeof(int));
+    set->nextSameHash = (int *)malloc(count * sizeof(int));
+    if (set->slotHash == NULL || set->slotPattern == NULL || set->nextSameHash == NULL) {
+        fprintf(stderr, "Memory allocation failed.\n");
+        exit(EXIT_FAILURE);
+    }
+    memset(set->slotPattern, -1, size * sizeof(int));
+
+    for (int id = 0; id < count; id++) {
+        uint64_t hash = 0;
+        for (size_t i = 0; i < m; i++)
+            hash = hashPush(rh, hash, (unsigned char)patterns[id][i]);
+        size_t slot = hash & set->mask;
+        while (set->slotPattern[slot] != -1 && set->slotHash[slot] != hash)
+            slot = (slot + 1) & set->mask;
+        if (set->slotPattern[slot] == -1)
+            set->slotHash[slot] = hash;
+        set->nextSameHash[id] = set->slotPattern[slot];
+        set->slotPattern[slot] = id;
+    }
+}
+
+static void freePatternHashSet(PatternHashSet *set) {
+    free(set->slotHash);
+    free(set->slotPattern);
+    free(set->nextSameHash);
+}
+
+/*
+ * Function: rabinKarpMultiScan
+ * ----------------------------
+ * Searches text for every one of 'count' patterns, which must all have the
+ * same length. Each pattern is hashed once into an open-addressing table;
+ * the text is scanned once and each window hash is looked up in O(1), so
+ * the cost does not grow with the number of patterns.
+ *
+ * Calls report(patternId, offset) for every match and returns the number
+ * of matches, or -1 if the patterns do not all have the same length.
+ */
+long long rabinKarpMultiScan(const char *const *patterns, int count, const char *text, size_t n,
+                             MultiMatchCallback report, void *ctx) {
+    memset(&rkStats, 0, sizeof(rkStats));
+    if (count <= 0)
+        return 0;
+    size_t m = strlen(patterns[0]);
+    for (int id = 1; id < count; id++) {
+        if (strlen(patterns[id]) != m)
+            return -1;
+    }
+    if (m == 0 || m > n)
+        return 0;
+
+    const unsigned char *t = (const unsigned char *)text;
+    RollingHash rh;
+    initRollingHash(&rh, (int)m);
+    PatternHashSet set;
+    buildPatternHashSet(&set, &rh, patterns, count, m);
+
+    uint64_t textHash = 0;
+    for (size_t i = 0; i < m; i++)
+        textHash = hashPush(&rh, textHash, t[i]);
+
+    for (size_t i = 0; i + m <= n; i++) {
+        size_t slot = textHash & set.mask;
+        while (set.slotPattern[slot] != -1) {
+            if (set.slotHash[slot] == textHash) {
+                long long before = rkStats.verifiedMatches;
+                rkStats.hashHits++;
+                for (int id = set.slotPattern[slot]; id != -1; id = set.nextSameHash[id]) {
+                    if (memcmp(text + i, patterns[id], m) == 0) {
+                        rkStats.verifiedMatches++;
+                        report(id, (long long)i, ctx);
+                    }
+                }
+                if (rkStats.verifiedMatches == before)
+                    rkStats.spuriousHits++;
+                break;
             }
+            slot = (slot + 1) & set.mask;
         }
+        if (i + m < n)
+            textHash = hashRoll(&rh, textHash, t[i], t[i + m]);
+    }
+    rkStats.windows = (long long)(n - m + 1);
+    freePatternHashSet(&set);
+    return rkStats.verifiedMatches;
+}
 
-        // Calculate hash value for the next window of text:
-        // Remove the leading digit and add the trailing digit.
-        if (i < n - m) {
-            textHash = (RADIX * (textHash - text[i] * h) + text[i + m]) % PRIME;
+void printRabinKarpStats(void) {
+    printf("\nWindows hashed   : %lld\n", rkStats.windows);
+    printf("Hash hits        : %lld\n", rkStats.hashHits);
+    printf("Verified matches : %lld\n", rkStats.verifiedMatches);
+    printf("Spurious hits    : %lld\n", rkStats.spuriousHits);
+}
+
+#ifndef RABIN_KARP_NO_MAIN
+static void printSetMatch(int patternId, long long offset, void *ctx) {
+    const char *const *patterns = (const char *const *)ctx;
+    printf("Pattern %d (\"%s\") found at index %lld\n", patternId, patterns[patternId], offset);
+}
 
-            // In case textHash becomes negative, convert it to positive.
-            if (textHash < 0)
-                textHash = textHash + PRIME;
+// Reads a whole file (or one line of stdin when path is NULL) into memory.
+// Pipes and FIFOs cannot seek, so the file size is only a hint for the
+// first buffer; reading goes on until EOF. Returns NULL on error.
+static char *readText(const char *path, size_t *length) {
+    if (path == NULL) {
+        static char line[1000];
+        printf("Enter the text: ");
+        if (fgets(line, sizeof(line), stdin) == NULL)
+            return NULL;
+        line[strcspn(line, "\n")] = '\0';
+        *length = strlen(line);
+        return line;
+    }
+    FILE *in = fopen(path, "rb");
+    if (in == NULL) {
+        perror(path);
+        return NULL;
+    }
+    size_t capacity = 1 << 16, used = 0;
+    if (fseek(in, 0, SEEK_END) == 0) {
+        long size = ftell(in);
+        if (size >= 0)
+            capacity = (size_t)size + 1;    // + 1 so EOF shows as a short read
+        rewind(in);
+    }
+    char *data = (char *)malloc(capacity);
+    while (data != NULL) {
+        used += fread(data + used, 1, capacity - used, in);
+        if (used < capacity)
+            break;
+        capacity *= 2;
+        char *grown = (char *)realloc(data, capacity);
+        if (grown == NULL)
+            free(data);
+        data = grown;
+    }
+    if (data == NULL) {
+        fprintf(stderr, "Memory allocation failed.\n");
+    } else if (ferror(in)) {
+        fprintf(stderr, "Error reading %s.\n", path);
+        free(data);
+        data = NULL;
+    }
+    fclose(in);
+    *length = used;
+    return data;
+}
+
+static void freePatternSet(char **patterns, int count) {
+    for (int i = 0; i < count; i++)
+        free(patterns[i]);
+    free(patterns);
+}
+
+// Pattern-set mode: ./rabinKarp <patterns-file> [text-file]
+// The patterns file holds one pattern per line, all of the same length.
+static int searchPatternSet(const char *patternPath, const char *textPath) {
+    FILE *in = fopen(patternPath, "r");
+    if (in == NULL) {
+        perror(patternPath);
+        return EXIT_FAILURE;
+    }
+    int count = 0, capacity = 64;
+    char **patterns = (char **)malloc(capacity * sizeof(char *));
+    char line[1000];
+    while (patterns != NULL && fgets(line, sizeof(line), in) != NULL) {
+        line[strcspn(line, "\r\n")] = '\0';
+        if (line[0] == '\0')
+            continue;
+        if (count == capacity) {
+            char **grown = (char **)realloc(patterns, 2 * capacity * sizeof(char *));
+            if (grown == NULL)
+                break;
+            patterns = grown;
+            capacity *= 2;
         }
+        patterns[count] = (char *)malloc(strlen(line) + 1);
+        if (patterns[count] == NULL)
+            break;
+        strcpy(patterns[count++], line);
+    }
+    int readAll = patterns != NULL && feof(in);
+    fclose(in);
+    if (!readAll) {
+        fprintf(stderr, "Memory allocation failed.\n");
+        if (patterns != NULL)
+            freePatternSet(patterns, count);
+        return EXIT_FAILURE;
     }
+
+    size_t n;
+    char *text = readText(textPath, &n);
+    if (text == NULL) {
+        fprintf(stderr, "Error reading text.\n");
+        freePatternSet(patterns, count);
+        return EXIT_FAILURE;
+    }
+    long long matches = rabinKarpMultiScan((const char *const *)patterns, count, text, n,
+                                           printSetMatch, patterns);
+    if (textPath != NULL)
+        free(text);
+    if (matches < 0) {
+        fprintf(stderr, "All patterns in the set must have the same length.\n");
+        freePatternSet(patterns, count);
+        return EXIT_FAILURE;
+    }
+    printf("Total matches: %lld (%d patterns)\n", matches, count);
+    printRabinKarpStats();
+    freePatternSet(patterns, count);
+    return EXIT_SUCCESS;
 }
 
-int main() {
+int main(int argc, char *argv[]) {
+    if (argc > 1)
+        return searchPatternSet(argv[1], argc > 2 ? argv[2] : NULL);
+
     char text[1000];
     char pattern[1000];
     printf("Enter the text: ");
@@ -74,5 +403,7 @@ int main() {
         return EXIT_SUCCESS;
     }
     rabinKarpSearch(pattern, text);
+    printRabinKarpStats();
     return EXIT_SUCCESS;
 }
+#endif
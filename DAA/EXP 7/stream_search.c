@@ -0,0 +1,284 @@
+/*
+ * Streaming pattern search over arbitrarily large files.
+ *
+ * kmp.c and rabinKarp.c need the whole text in one buffer. Here the text is
+ * consumed in fixed-size chunks (or through one mmap of the file), and the
+ * matcher state is carried from one chunk to the next:
+ *
+ *   KMP         - the number of matched characters q survives the chunk
+ *                 boundary, exactly as it survives one loop iteration.
+ *   Rabin-Karp  - the rolling hash survives the boundary; the current
+ *                 window is kept in an m-byte ring buffer so the leaving
+ *                 byte can be removed and hash hits can be verified even
+ *                 when the window started in the previous chunk.
+ *
+ * Memory use is O(m + chunk size) regardless of file size, and offsets are
+ * 64-bit and absolute from the start of the file.
+ *
+ * Usage: ./stream_search [kmp|rk] <pattern> <file> [--mmap] [--chunk BYTES] [--count]
+ * Compile with: gcc -O2 -o stream_search stream_search.c
+ */
+
+#define KMP_NO_MAIN
+#define RABIN_KARP_NO_MAIN
+#include "kmp.c"
+#include "rabinKarp.c"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define DEFAULT_CHUNK (1 << 20)
+
+// -------------------------- KMP stream --------------------------
+typedef struct {
+    const char *pattern;
+    int m;
+    int *prefixArray;
+    int q;               // characters matched so far (carried across chunks)
+    long long consumed;  // absolute offset of the next byte to be fed
+} KmpStream;
+
+void kmpStreamInit(KmpStream *ks, const char *pattern) {
+    ks->pattern = pattern;
+    ks->m = (int)strlen(pattern);
+    ks->prefixArray = (int *)malloc(ks->m * sizeof(int));
+    if (ks->prefixArray == NULL) {
+        fprintf(stderr, "Memory allocation failed.\n");
+        exit(EXIT_FAILURE);
+    }
+    computePrefixFunction(pattern, ks->m, ks->prefixArray);
+    ks->q = 0;
+    ks->consumed = 0;
+}
+
+long long kmpStreamFeed(KmpStream *ks, const char *chunk, size_t len,
+                        MatchCallback report, void *ctx) {
+    const char *pattern = ks->pattern;
+    const int *prefixArray = ks->prefixArray;
+    int m = ks->m, q = ks->q;
+    long long matches = 0;
+
+    for (size_t i = 0; i < len; i++) {
+        while (q > 0 && pattern[q] != chunk[i])
+            q = prefixArray[q - 1];
+        if (pattern[q] == chunk[i])
+            q++;
+        if (q == m) {
+            report(ks->consumed + (long long)i - m + 1, ctx);
+            matches++;
+            q = prefixArray[q - 1];
+        }
+    }
+    ks->q = q;
+    ks->consumed += (long long)len;
+    return matches;
+}
+
+void kmpStreamFree(KmpStream *ks) {
+    free(ks->prefixArray);
+}
+
+// -------------------------- Rabin-Karp stream --------------------------
+// Uses the same mod 2^61 - 1 rolling hash as rabinKarpScan().
+typedef struct {
+    const char *pattern;
+    int m;
+    RollingHash hash;
+    uint64_t patternHash, windowHash;
+    char *window;        // ring buffer holding the last m bytes
+    int head;            // index of the oldest byte in window
+    int filled;          // bytes in window (< m only at the start)
+    long long consumed;
+} RabinKarpStream;
+
+void rkStreamInit(RabinKarpStream *rs, const char *pattern) {
+    rs->pattern = pattern;
+    rs->m = (int)strlen(pattern);
+    rs->window = (char *)malloc(rs->m);
+    if (rs->window == NULL) {
+        fprintf(stderr, "Memory allocation failed.\n");
+        exit(EXIT_FAILURE);
+    }
+    initRollingHash(&rs->hash, rs->m);
+    rs->patternHash = 0;
+    for (int i = 0; i < rs->m; i++)
+        rs->patternHash = hashPush(&rs->hash, rs->patternHash, (unsigned char)pattern[i]);
+    rs->windowHash = 0;
+    rs->head = rs->filled = 0;
+    rs->consumed = 0;
+}
+
+// Compares the ring buffer (oldest byte first) with the pattern.
+static int rkWindowEquals(const RabinKarpStream *rs) {
+    int tail = rs->m - rs->head;
+    return memcmp(rs->window + rs->head, rs->pattern, tail) == 0 &&
+           memcmp(rs->window, rs->pattern + tail, rs->head) == 0;
+}
+
+long long rkStreamFeed(RabinKarpStream *rs, const char *chunk, size_t len,
+                       MatchCallback report, void *ctx) {
+    int m = rs->m;
+    uint64_t hash = rs->windowHash;
+    long long matches = 0;
+
+    for (size_t i = 0; i < len; i++) {
+        char c = chunk[i];
+        if (rs->filled < m) {
+            hash = hashPush(&rs->hash, hash, (unsigned char)c);
+            rs->window[rs->filled++] = c;
+        } else {
+            // Remove the leading byte and add the trailing one.
+            hash = hashRoll(&rs->hash, hash, (unsigned char)rs->window[rs->head], (unsigned char)c);
+            rs->window[rs->head] = c;
+            rs->head = (rs->head + 1 == m) ? 0 : rs->head + 1;
+        }
+        if (rs->filled == m && hash == rs->patternHash && rkWindowEquals(rs)) {
+            report(rs->consumed + (long long)i - m + 1, ctx);
+            matches++;
+        }
+    }
+    rs->windowHash = hash;
+    rs->consumed += (long long)len;
+    return matches;
+}
+
+void rkStreamFree(RabinKarpStream *rs) {
+    free(rs->window);
+}
+
+// -------------------------- File drivers --------------------------
+typedef enum { STREAM_KMP, STREAM_RABIN_KARP } StreamAlgorithm;
+
+typedef struct {
+    StreamAlgorithm algorithm;
+    KmpStream kmp;
+    RabinKarpStream rk;
+} StreamMatcher;
+
+static long long feedMatcher(StreamMatcher *sm, const char *chunk, size_t len,
+                             MatchCallback report, void *ctx) {
+    if (sm->algorithm == STREAM_KMP)
+        return kmpStreamFeed(&sm->kmp, chunk, len, report, ctx);
+    return rkStreamFeed(&sm->rk, chunk, len, report, ctx);
+}
+
+/*
+ * Function: streamSearchFile
+ * --------------------------
+ * Searches 'path' for 'pattern' reading 'chunkSize' bytes at a time, or
+ * through a single read-only mapping when useMmap is set. Returns the
+ * number of matches, or -1 if the file cannot be read.
+ */
+long long streamSearchFile(const char *path, const char *pattern, StreamAlgorithm algorithm,
+                           size_t chunkSize, int useMmap, MatchCallback report, void *ctx) {
+    StreamMatcher sm;
+    sm.algorithm = algorithm;
+    if (algorithm == STREAM_KMP)
+        kmpStreamInit(&sm.kmp, pattern);
+    else
+        rkStreamInit(&sm.rk, pattern);
+
+    long long matches = -1;
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        perror(path);
+    } else if (useMmap) {
+        struct stat st;
+        if (fstat(fd, &st) != 0) {
+            perror(path);
+        } else if (st.st_size == 0) {
+            matches = 0;
+        } else {
+            char *data = (char *)mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (data == MAP_FAILED) {
+                perror("mmap");
+            } else {
+                madvise(data, st.st_size, MADV_SEQUENTIAL);
+                // Feed the mapping in chunks too so pages already scanned can
+                // be dropped; the matcher state makes the split invisible.
+                // madvise() needs page-aligned ranges and chunkSize need not
+                // be a page multiple, so only whole pages behind the scan
+                // position are released.
+                off_t pageSize = (off_t)sysconf(_SC_PAGESIZE);
+                off_t released = 0;     // pages before this offset are dropped
+                matches = 0;
+                for (off_t pos = 0; pos < st.st_size; pos += (off_t)chunkSize) {
+                    size_t len = (size_t)(st.st_size - pos) < chunkSize
+                                     ? (size_t)(st.st_size - pos) : chunkSize;
+                    matches += feedMatcher(&sm, data + pos, len, report, ctx);
+                    off_t scanned = (pos + (off_t)len) / pageSize * pageSize;
+                    if (released >= 0 && scanned > released) {
+                        if (madvise(data + released, scanned - released, MADV_DONTNEED) != 0) {
+                            perror("madvise");
+                            released = -1;  // keep searching, stop releasing
+                        } else {
+                            released = scanned;
+                        }
+                    }
+                }
+                munmap(data, st.st_size);
+            }
+        }
+    } else {
+        char *chunk = (char *)malloc(chunkSize);
+        ssize_t got;
+        matches = 0;
+        while ((got = read(fd, chunk, chunkSize)) > 0)
+            matches += feedMatcher(&sm, chunk, (size_t)got, report, ctx);
+        if (got < 0) {
+            perror(path);
+            matches = -1;
+        }
+        free(chunk);
+    }
+    if (fd >= 0)
+        close(fd);
+
+    if (algorithm == STREAM_KMP)
+        kmpStreamFree(&sm.kmp);
+    else
+        rkStreamFree(&sm.rk);
+    return matches;
+}
+
+static void countOnly(long long offset, void *ctx) {
+    (void)offset;
+    (void)ctx;
+}
+
+#ifndef STREAM_SEARCH_NO_MAIN
+int main(int argc, char *argv[]) {
+    if (argc < 4 || (strcmp(argv[1], "kmp") != 0 && strcmp(argv[1], "rk") != 0)) {
+        fprintf(stderr, "Usage: %s [kmp|rk] <pattern> <file> [--mmap] [--chunk BYTES] [--count]\n",
+                argv[0]);
+        return EXIT_FAILURE;
+    }
+    StreamAlgorithm algorithm = (strcmp(argv[1], "kmp") == 0) ? STREAM_KMP : STREAM_RABIN_KARP;
+    const char *pattern = argv[2];
+    const char *path = argv[3];
+    size_t chunkSize = DEFAULT_CHUNK;
+    int useMmap = 0, countOnlyMode = 0;
+
+    for (int i = 4; i < argc; i++) {
+        if (strcmp(argv[i], "--mmap") == 0)
+            useMmap = 1;
+        else if (strcmp(argv[i], "--count") == 0)
+            countOnlyMode = 1;
+        else if (strcmp(argv[i], "--chunk") == 0 && i + 1 < argc)
+            chunkSize = (size_t)strtoull(argv[++i], NULL, 10);
+    }
+    if (pattern[0] == '\0' || chunkSize == 0) {
+        fprintf(stderr, "Pattern and chunk size must be non-empty.\n");
+        return EXIT_FAILURE;
+    }
+
+    long long matches = streamSearchFile(path, pattern, algorithm, chunkSize, useMmap,
+                                         countOnlyMode ? countOnly : printMatchIndex, NULL);
+    if (matches < 0)
+        return EXIT_FAILURE;
+    printf("Total matches: %lld\n", matches);
+    return EXIT_SUCCESS;
+}
+#endif
@@ -0,0 +1,320 @@
+/*
+ * Benchmark for the single-pattern matchers in this directory.
+ *
+ * Compares the scanners behind string_search.c (KMP with and without the
+ * DFA, SIMD filter, Horspool, Two-Way, Rabin-Karp) with a naive scan,
+ * glibc memmem() and std::search on four generated texts:
+ *
+ *   dna          uniform over ACGT
+ *   english      Zipf-distributed words from a small vocabulary, with spaces
+ *                and punctuation
+ *   binary       uniform random bytes
+ *   adversarial  a^n b, searched for a^(m-1-j) b a^j with j = (m-1)/2: every
+ *                position matches about m/2 bytes before failing, which is
+ *                the worst case for naive scanning and the SIMD first/last
+ *                filter
+ *
+ * For the first three texts each pattern is cut from a random position in
+ * the text, so there is at least one match. Pattern lengths sweep the powers
+ * of two from 2 to 4096. Each measurement scans a prefix of the text that
+ * grows until the run takes at least --min-time seconds (or covers the whole
+ * text), so quadratic cases finish in bounded time. Throughput is text bytes
+ * scanned per second.
+ *
+ * Every algorithm must report the same number of matches as memmem() (linear
+ * time in glibc) on the same prefix; a mismatch is printed and makes the
+ * exit status 1.
+ *
+ * Each row names the fastest algorithm and the one selectMatcher() picks.
+ * The summary gives, per text, the largest length at which the SIMD filter
+ * is still the fastest of the candidates selectMatcher() chooses from, and
+ * how far the pick falls behind the fastest candidate at its worst length.
+ * SIMD_MAX_PATTERN (kmp.c) and HORSPOOL_MIN_ALPHABET (string_search.c) are
+ * set from this output.
+ *
+ * Usage: ./string_bench [--size MB] [--min-time S] [--max-length M]
+ * Compile with: g++ -std=c++17 -O2 -march=native -o string_bench string_bench.cpp
+ */
+#define STRING_SEARCH_NO_MAIN
+#include "string_search.c"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+using namespace std;
+
+static void countMatch(long long offset, void *ctx) {
+    (void)offset;
+    (*(long long *)ctx)++;
+}
+
+static long long naiveCount(const char *pattern, size_t m, const char *text, size_t n) {
+    long long matches = 0;
+    for (size_t i = 0; i + m <= n; i++) {
+        size_t j = 0;
+        while (j < m && text[i + j] == pattern[j])
+            j++;
+        if (j == m)
+            matches++;
+    }
+    return matches;
+}
+
+static long long memmemCount(const char *pattern, size_t m, const char *text, size_t n) {
+    long long matches = 0;
+    const char *p = text, *end = text + n;
+    while (p + m <= end) {
+        const char *hit = (const char *)memmem(p, end - p, pattern, m);
+        if (hit == NULL)
+            break;
+        matches++;
+        p = hit + 1;
+    }
+    return matches;
+}
+
+static long long stdSearchCount(const char *pattern, size_t m, const char *text, size_t n) {
+    long long matches = 0;
+    const char *p = text, *end = text + n;
+    for (;;) {
+        p = search(p, end, pattern, pattern + m);
+        if (p == end)
+            break;
+        matches++;
+        p++;
+    }
+    return matches;
+}
+
+// KMP through the prefix function only, as it was before buildKmpDfa().
+static long long kmpPrefixCount(const char *pattern, size_t m, const char *text, size_t n) {
+    vector<int> prefixArray(m);
+    computePrefixFunction(pattern, (int)m, prefixArray.data());
+    long long matches = 0;
+    kmpScan(pattern, m, prefixArray.data(), text, n, countMatch, &matches);
+    return matches;
+}
+
+static function<long long(const char *, size_t, const char *, size_t)>
+matcherCounter(MatcherKind kind) {
+    return [kind](const char *pattern, size_t m, const char *text, size_t n) {
+        long long matches = 0;
+        runMatcher(kind, pattern, m, text, n, countMatch, &matches);
+        return matches;
+    };
+}
+
+struct Algorithm {
+    string name;
+    function<long long(const char *, size_t, const char *, size_t)> count;
+    bool candidate;     // one of the matchers selectMatcher() picks from
+};
+
+// ------------------------------ Text generators ------------------------------
+static uint64_t benchState = 0x9E3779B97F4A7C15ULL;
+
+static uint64_t nextRandom() {
+    benchState ^= benchState << 13;
+    benchState ^= benchState >> 7;
+    benchState ^= benchState << 17;
+    return benchState;
+}
+
+static string makeDna(size_t n) {
+    static const char bases[] = "ACGT";
+    string text(n, 'A');
+    for (size_t i = 0; i < n; i++)
+        text[i] = bases[nextRandom() & 3];
+    return text;
+}
+
+static string makeBinary(size_t n) {
+    string text(n, '\0');
+    for (size_t i = 0; i < n; i++)
+        text[i] = (char)(nextRandom() & 0xFF);
+    return text;
+}
+
+// Words of 1-12 letters drawn with English-like letter frequencies; word
+// rank r is chosen with probability proportional to 1 / (r + 1).
+static string makeEnglish(size_t n) {
+    static const char letters[] = "eeeeeeeeeeeettttttttaaaaaaaooooooiiiiiinnnnnnsssssshhhhhrrrrrdddlllcccuummwwffggyyppbbvkjxqz";
+    const size_t letterCount = sizeof(letters) - 1;
+    const int vocabulary = 5000;
+    vector<string> words(vocabulary);
+    for (auto &word : words) {
+        size_t length = 1 + nextRandom() % 12;
+        for (size_t i = 0; i < length; i++)
+            word += letters[nextRandom() % letterCount];
+    }
+    vector<double> cumulative(vocabulary);
+    double total = 0;
+    for (int r = 0; r < vocabulary; r++) {
+        total += 1.0 / (r + 1);
+        cumulative[r] = total;
+    }
+    static const char punctuation[] = ",.;\n";
+    string text;
+    text.reserve(n + 16);
+    while (text.size() < n) {
+        double u = (nextRandom() >> 11) * (1.0 / 9007199254740992.0) * total;
+        size_t r = lower_bound(cumulative.begin(), cumulative.end(), u) - cumulative.begin();
+        text += words[min(r, (size_t)vocabulary - 1)];
+        text += (nextRandom() % 10 == 0) ? punctuation[nextRandom() % 4] : ' ';
+    }
+    text.resize(n);
+    return text;
+}
+
+static string makeAdversarial(size_t n) {
+    string text(n, 'a');
+    text[n - 1] = 'b';
+    return text;
+}
+
+static string adversarialPattern(size_t m) {
+    size_t j = (m - 1) / 2;
+    return string(m - 1 - j, 'a') + 'b' + string(j, 'a');
+}
+
+// --------------------------------- Timing ---------------------------------
+struct Measurement {
+    double gbPerSecond;
+    bool agrees;
+};
+
+static double now() {
+    return chrono::duration<double>(chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Scans growing prefixes of the text until one run takes minTime.
+static Measurement measure(const Algorithm &algo, const string &pattern, const string &text,
+                           double minTime) {
+    size_t m = pattern.size();
+    size_t length = min(text.size(), max((size_t)1 << 16, 4 * m));
+    for (;;) {
+        double start = now();
+        long long matches = algo.count(pattern.data(), m, text.data(), length);
+        double seconds = now() - start;
+        if (seconds >= minTime || length == text.size()) {
+            long long expected = memmemCount(pattern.data(), m, text.data(), length);
+            return {seconds > 0 ? length / seconds / 1e9 : 0.0, matches == expected};
+        }
+        double scale = seconds > 0 ? 1.5 * minTime / seconds : 16.0;
+        length = (size_t)min((double)text.size(), length * min(max(scale, 2.0), 16.0));
+    }
+}
+
+int main(int argc, char *argv[]) {
+    size_t megabytes = 32;
+    double minTime = 0.1;
+    size_t maxLength = 4096;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--size") == 0 && i + 1 < argc)
+            megabytes = strtoul(argv[++i], NULL, 10);
+        else if (strcmp(argv[i], "--min-time") == 0 && i + 1 < argc)
+            minTime = atof(argv[++i]);
+        else if (strcmp(argv[i], "--max-length") == 0 && i + 1 < argc)
+            maxLength = strtoul(argv[++i], NULL, 10);
+    }
+    size_t n = max(megabytes, (size_t)1) << 20;
+
+    vector<Algorithm> algorithms = {
+        {"naive", naiveCount, false},
+        {"memmem", memmemCount, false},
+        {"std::search", stdSearchCount, false},
+        {"kmp-prefix", kmpPrefixCount, false},
+        {"kmp", matcherCounter(MATCHER_KMP), false},
+        {"rk", matcherCounter(MATCHER_RABIN_KARP), false},
+        {"simd", matcherCounter(MATCHER_SIMD), true},
+        {"horspool", matcherCounter(MATCHER_HORSPOOL), true},
+        {"twoway", matcherCounter(MATCHER_TWO_WAY), true},
+    };
+    struct Corpus {
+        string name;
+        string text;
+    };
+    vector<Corpus> corpora;
+    corpora.push_back({"dna", makeDna(n)});
+    corpora.push_back({"english", makeEnglish(n)});
+    corpora.push_back({"binary", makeBinary(n)});
+    corpora.push_back({"adversarial", makeAdversarial(n)});
+
+    bool allAgree = true;
+    vector<string> summary;
+    cout << fixed << setprecision(2);
+    for (const Corpus &corpus : corpora) {
+        cout << "\n== " << corpus.name << " (" << (n >> 20) << " MB), GB/s ==\n";
+        cout << setw(6) << "m";
+        for (const Algorithm &algo : algorithms)
+            cout << setw(13) << algo.name;
+        cout << "\n";
+
+        size_t simdLimit = 0;
+        bool simdStillBest = true;
+        double worstPickRatio = 1.0;    // picked / best candidate, over all lengths
+        size_t worstPickLength = 0;
+        for (size_t m = 2; m <= maxLength; m *= 2) {
+            string pattern;
+            if (corpus.name == "adversarial")
+                pattern = adversarialPattern(m);
+            else
+                pattern = corpus.text.substr(nextRandom() % (n - m), m);
+
+            cout << setw(6) << m;
+            string fastest;
+            double fastestRate = -1, bestCandidateRate = -1;
+            string bestCandidate;
+            const char *picked = matcherName(selectMatcher(pattern.data(), m));
+            double pickedRate = 0;
+            for (const Algorithm &algo : algorithms) {
+                Measurement result = measure(algo, pattern, corpus.text, minTime);
+                cout << setw(12) << result.gbPerSecond << (result.agrees ? ' ' : '!');
+                if (!result.agrees) {
+                    allAgree = false;
+                    cerr << "Match count mismatch: " << algo.name << " on " << corpus.name
+                         << ", m = " << m << "\n";
+                }
+                if (result.gbPerSecond > fastestRate) {
+                    fastestRate = result.gbPerSecond;
+                    fastest = algo.name;
+                }
+                if (algo.name == picked)
+                    pickedRate = result.gbPerSecond;
+                if (algo.candidate && result.gbPerSecond > bestCandidateRate) {
+                    bestCandidateRate = result.gbPerSecond;
+                    bestCandidate = algo.name;
+                }
+            }
+            cout << "   fastest: " << fastest << ", picked: " << picked << "\n";
+            if (bestCandidateRate > 0 && pickedRate / bestCandidateRate < worstPickRatio) {
+                worstPickRatio = pickedRate / bestCandidateRate;
+                worstPickLength = m;
+            }
+            if (simdStillBest && bestCandidate == "simd")
+                simdLimit = m;
+            else
+                simdStillBest = false;
+        }
+        string line = corpus.name + ": SIMD filter fastest up to m = " + to_string(simdLimit) +
+                      "; selectMatcher() ";
+        if (worstPickLength == 0) {
+            line += "always picks the fastest candidate";
+        } else {
+            line += "worst at m = " + to_string(worstPickLength) + ", " +
+                    to_string((int)(100 * worstPickRatio + 0.5)) + "% of the fastest candidate";
+        }
+        summary.push_back(line);
+    }
+
+    cout << "\nSummary (SIMD_MAX_PATTERN = " << SIMD_MAX_PATTERN
+         << ", HORSPOOL_MIN_ALPHABET = " << HORSPOOL_MIN_ALPHABET << ")\n";
+    for (const string &line : summary)
+        cout << "  " << line << "\n";
+    return allAgree ? 0 : 1;
+}
@@ -0,0 +1,26 @@
+#ifndef STRING_MATCH_H
+#define STRING_MATCH_H
+
+#include <stdio.h>
+
+/*
+ * Shared contract for the single-pattern matchers in this directory.
+ *
+ * A scanner reports each match by calling MatchCallback with the 0-based
+ * offset of the first matched byte, in increasing offset order, and returns
+ * the number of matches. The printing front-ends (KMP(), simdSearch(), ...)
+ * pass printMatchIndex so they all produce the same
+ * "Pattern found at index N" lines.
+ */
+typedef void (*MatchCallback)(long long offset, void *ctx);
+
+// Multi-pattern matchers (Aho-Corasick, pattern-set Rabin-Karp) also pass
+// the index of the pattern that matched.
+typedef void (*MultiMatchCallback)(int patternId, long long offset, void *ctx);
+
+void printMatchIndex(long long offset, void *ctx) {
+    (void)ctx;
+    printf("Pattern found at index %lld\n", offset);
+}
+
+#endif
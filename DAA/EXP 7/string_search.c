@@ -0,0 +1,202 @@
+/*
+ * Matcher selection for single-pattern search.
+ *
+ * Every matcher in this directory implements the same MatchCallback
+ * contract (string_match.h); this file picks one for a given pattern and
+ * runs it:
+ *
+ *   m <= SIMD_MAX_PATTERN           SIMD first/last-byte filter (kmp.c).
+ *                                   Verification costs at most m bytes per
+ *                                   candidate; on a^n b it runs at a
+ *                                   roughly constant 12-25% of Two-Way
+ *                                   for every m up to the limit.
+ *   longer, >= HORSPOOL_MIN_ALPHABET Boyer-Moore-Horspool (horspool.c): with
+ *   distinct pattern bytes           many distinct bytes the bad-character
+ *                                   shift is close to m, so it skips most
+ *                                   of the text.
+ *   longer, small alphabet          Two-Way (two_way.c): Horspool's shifts
+ *                                   collapse on DNA/binary-like patterns;
+ *                                   Two-Way stays linear in O(1) space.
+ *                                   On random DNA it is ~5x slower than
+ *                                   the filter, the price of a worst case
+ *                                   that does not degrade with m.
+ *
+ * KMP and Rabin-Karp are available by name. KMP is never picked
+ * automatically: its DFA takes 1 KB per pattern byte, and on the texts in
+ * string_bench.cpp it is never the fastest at any length. The thresholds
+ * below come from that benchmark.
+ *
+ * Usage: ./string_search [--algo auto|kmp|simd|horspool|twoway|rk]
+ * Compile with: gcc -O2 -march=native -o string_search string_search.c
+ */
+#define KMP_NO_MAIN
+#define RABIN_KARP_NO_MAIN
+#define HORSPOOL_NO_MAIN
+#define TWO_WAY_NO_MAIN
+#include "kmp.c"
+#include "rabinKarp.c"
+#include "horspool.c"
+#include "two_way.c"
+
+#define HORSPOOL_MIN_ALPHABET 8
+
+typedef enum {
+    MATCHER_KMP,
+    MATCHER_SIMD,
+    MATCHER_HORSPOOL,
+    MATCHER_TWO_WAY,
+    MATCHER_RABIN_KARP
+} MatcherKind;
+
+static const char *const matcherNames[] = {"kmp", "simd", "horspool", "twoway", "rk"};
+
+const char *matcherName(MatcherKind kind) {
+    return matcherNames[kind];
+}
+
+// Returns 0 and sets *kind if 'name' is a matcher name, -1 otherwise.
+int parseMatcher(const char *name, MatcherKind *kind) {
+    for (int k = 0; k < (int)(sizeof(matcherNames) / sizeof(matcherNames[0])); k++) {
+        if (strcmp(name, matcherNames[k]) == 0) {
+            *kind = (MatcherKind)k;
+            return 0;
+        }
+    }
+    return -1;
+}
+
+/*
+ * Function: selectMatcher
+ * -----------------------
+ * Chooses a matcher from the pattern length and the number of distinct
+ * bytes in the pattern (a cheap proxy for the text alphabet).
+ */
+MatcherKind selectMatcher(const char *pattern, size_t m) {
+    if (m <= SIMD_MAX_PATTERN)
+        return MATCHER_SIMD;
+    unsigned char seen[256] = {0};
+    int distinct = 0;
+    for (size_t i = 0; i < m && distinct < HORSPOOL_MIN_ALPHABET; i++) {
+        unsigned char c = (unsigned char)pattern[i];
+        if (!seen[c]) {
+            seen[c] = 1;
+            distinct++;
+        }
+    }
+    return distinct >= HORSPOOL_MIN_ALPHABET ? MATCHER_HORSPOOL : MATCHER_TWO_WAY;
+}
+
+/*
+ * A matcher ready to scan. prepareMatcher() builds the per-pattern state
+ * once and scanMatcher() only reads it, so threads scanning different
+ * slices of one text (parallel_search.c) can share a single
+ * PreparedMatcher. Only KMP has state worth sharing: its prefix function
+ * and DFA, 1 KB per pattern byte. The other scanners set up O(m + 256)
+ * tables inside each call.
+ */
+typedef struct {
+    MatcherKind kind;
+    const char *pattern;
+    size_t m;
+    int *prefixArray;       // KMP only
+    uint32_t *dfa;          // KMP only; NULL means kmpScan() on prefixArray
+} PreparedMatcher;
+
+// Returns 0 on success, -1 if memory runs out.
+int prepareMatcher(PreparedMatcher *pm, MatcherKind kind, const char *pattern, size_t m) {
+    pm->kind = kind;
+    pm->pattern = pattern;
+    pm->m = m;
+    pm->prefixArray = NULL;
+    pm->dfa = NULL;
+    if (kind == MATCHER_KMP && m > 0) {
+        pm->prefixArray = (int *)malloc(m * sizeof(int));
+        if (pm->prefixArray == NULL) {
+            fprintf(stderr, "Memory allocation failed.\n");
+            return -1;
+        }
+        computePrefixFunction(pattern, (int)m, pm->prefixArray);
+        pm->dfa = buildKmpDfa(pattern, m, pm->prefixArray);
+    }
+    return 0;
+}
+
+// Runs a prepared matcher over text[0..n); returns the number of matches.
+long long scanMatcher(const PreparedMatcher *pm, const char *text, size_t n,
+                      MatchCallback report, void *ctx) {
+    const char *pattern = pm->pattern;
+    size_t m = pm->m;
+    switch (pm->kind) {
+    case MATCHER_KMP:
+        if (m == 0)
+            return 0;
+        return pm->dfa != NULL ? kmpDfaScan(pm->dfa, m, text, n, report, ctx)
+                               : kmpScan(pattern, m, pm->prefixArray, text, n, report, ctx);
+    case MATCHER_SIMD:
+        return simdScan(pattern, m, text, n, report, ctx);
+    case MATCHER_HORSPOOL:
+        return horspoolScan(pattern, m, text, n, report, ctx);
+    case MATCHER_TWO_WAY:
+        return twoWayScan(pattern, m, text, n, report, ctx);
+    case MATCHER_RABIN_KARP:
+        return rabinKarpScan(pattern, m, text, n, report, ctx);
+    }
+    return 0;
+}
+
+void freePreparedMatcher(PreparedMatcher *pm) {
+    free(pm->dfa);
+    free(pm->prefixArray);
+}
+
+// Prepares, runs and frees the given matcher over text[0..n); returns the
+// number of matches.
+long long runMatcher(MatcherKind kind, const char *pattern, size_t m, const char *text, size_t n,
+                     MatchCallback report, void *ctx) {
+    PreparedMatcher pm;
+    if (prepareMatcher(&pm, kind, pattern, m) != 0)
+        return 0;
+    long long matches = scanMatcher(&pm, text, n, report, ctx);
+    freePreparedMatcher(&pm);
+    return matches;
+}
+
+#ifndef STRING_SEARCH_NO_MAIN
+int main(int argc, char *argv[]) {
+    int automatic = 1;
+    MatcherKind kind = MATCHER_SIMD;
+    if (argc > 2 && strcmp(argv[1], "--algo") == 0 && strcmp(argv[2], "auto") != 0) {
+        if (parseMatcher(argv[2], &kind) != 0) {
+            fprintf(stderr, "Unknown matcher '%s'.\n", argv[2]);
+            return EXIT_FAILURE;
+        }
+        automatic = 0;
+    }
+
+    char text[1000];
+    char pattern[1000];
+    printf("Enter the text: ");
+    if (fgets(text, sizeof(text), stdin) == NULL) {
+        fprintf(stderr, "Error reading text.\n");
+        return EXIT_FAILURE;
+    }
+    text[strcspn(text, "\n")] = '\0';
+    printf("Enter the pattern: ");
+    if (fgets(pattern, sizeof(pattern), stdin) == NULL) {
+        fprintf(stderr, "Error reading pattern.\n");
+        return EXIT_FAILURE;
+    }
+    pattern[strcspn(pattern, "\n")] = '\0';
+
+    size_t m = strlen(pattern), n = strlen(text);
+    if (m > n) {
+        printf("No occurrences (pattern is longer than text).\n");
+        return EXIT_SUCCESS;
+    }
+    if (automatic)
+        kind = selectMatcher(pattern, m);
+    printf("Using %s\n", matcherName(kind));
+    runMatcher(kind, pattern, m, text, n, printMatchIndex, NULL);
+    return EXIT_SUCCESS;
+}
+#endif
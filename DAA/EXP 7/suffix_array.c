@@ -0,0 +1,400 @@
+/*
+ * Suffix array + LCP index for repeated queries on a fixed text.
+ *
+ * KMP() rescans the whole text for every pattern. Here the text is indexed
+ * once:
+ *   - the suffix array SA (SA-IS, linear time) lists the starting positions
+ *     of all suffixes in sorted order, so all occurrences of a pattern form
+ *     one contiguous block SA[lo..hi);
+ *   - the LCP array (Kasai, linear time) stores the longest common prefix
+ *     of neighbouring suffixes, used here for the longest repeated
+ *     substring report.
+ * The index (text + SA + LCP) is written to disk, and each query is two
+ * binary searches over SA: O(m log n) to count, plus O(occ) to locate.
+ *
+ * Texts are limited to 2^31 - 1 bytes (32-bit SA entries).
+ *
+ * Usage:
+ *   ./suffix_array build <text-file> <index-file>
+ *   ./suffix_array query <index-file> [--locate]   (patterns on stdin, one per line)
+ *   ./suffix_array repeat <index-file>
+ * Compile with: gcc -O2 -o suffix_array suffix_array.c
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#define INDEX_MAGIC "SAIDX01"
+
+// -------------------------- SA-IS --------------------------
+// s[0..n) is a string over [0, K) whose last symbol is a unique 0 sentinel.
+static void getBuckets(const int *s, int n, int K, int *bkt, int end) {
+    memset(bkt, 0, K * sizeof(int));
+    for (int i = 0; i < n; i++)
+        bkt[s[i]]++;
+    int sum = 0;
+    for (int c = 0; c < K; c++) {
+        sum += bkt[c];
+        bkt[c] = end ? sum : sum - bkt[c];
+    }
+}
+
+// type[i] = 1 if suffix i is S-type (smaller than suffix i+1), 0 if L-type.
+#define IS_LMS(i) ((i) > 0 && type[i] && !type[(i) - 1])
+
+static void induceSort(const int *s, int *sa, const char *type, int n, int K, int *bkt) {
+    // L-type suffixes, left to right from bucket heads
+    getBuckets(s, n, K, bkt, 0);
+    for (int i = 0; i < n; i++) {
+        int j = sa[i] - 1;
+        if (sa[i] > 0 && !type[j])
+            sa[bkt[s[j]]++] = j;
+    }
+    // S-type suffixes, right to left from bucket tails
+    getBuckets(s, n, K, bkt, 1);
+    for (int i = n - 1; i >= 0; i--) {
+        int j = sa[i] - 1;
+        if (sa[i] > 0 && type[j])
+            sa[--bkt[s[j]]] = j;
+    }
+}
+
+static void sais(const int *s, int *sa, int n, int K) {
+    char *type = (char *)malloc(n);
+    int *bkt = (int *)malloc(K * sizeof(int));
+    if (type == NULL || bkt == NULL) {
+        fprintf(stderr, "Memory allocation failed.\n");
+        exit(EXIT_FAILURE);
+    }
+    type[n - 1] = 1;
+    for (int i = n - 2; i >= 0; i--)
+        type[i] = (s[i] < s[i + 1] || (s[i] == s[i + 1] && type[i + 1])) ? 1 : 0;
+
+    // 1. Sort LMS substrings: seed LMS positions at bucket tails and induce.
+    getBuckets(s, n, K, bkt, 1);
+    for (int i = 0; i < n; i++)
+        sa[i] = -1;
+    for (int i = 1; i < n; i++) {
+        if (IS_LMS(i))
+            sa[--bkt[s[i]]] = i;
+    }
+    induceSort(s, sa, type, n, K, bkt);
+
+    // 2. Compact the sorted LMS positions and name equal LMS substrings.
+    int n1 = 0;
+    for (int i = 0; i < n; i++) {
+        if (IS_LMS(sa[i]))
+            sa[n1++] = sa[i];
+    }
+    for (int i = n1; i < n; i++)
+        sa[i] = -1;
+    int name = 0, prev = -1;
+    for (int i = 0; i < n1; i++) {
+        int pos = sa[i], diff = 0;
+        for (int d = 0; d < n; d++) {
+            if (prev == -1 || s[pos + d] != s[prev + d] || type[pos + d] != type[prev + d]) {
+                diff = 1;
+                break;
+            } else if (d > 0 && (IS_LMS(pos + d) || IS_LMS(prev + d))) {
+                break;
+            }
+        }
+        if (diff) {
+            name++;
+            prev = pos;
+        }
+        sa[n1 + pos / 2] = name - 1;
+    }
+    for (int i = n - 1, j = n - 1; i >= n1; i--) {
+        if (sa[i] >= 0)
+            sa[j--] = sa[i];
+    }
+
+    // 3. Sort the reduced string (recursively if names are not unique).
+    int *s1 = sa + n - n1, *sa1 = sa;
+    if (name < n1) {
+        sais(s1, sa1, n1, name);
+    } else {
+        for (int i = 0; i < n1; i++)
+            sa1[s1[i]] = i;
+    }
+
+    // 4. Induce the full SA from the sorted LMS suffixes.
+    getBuckets(s, n, K, bkt, 1);
+    for (int i = 1, j = 0; i < n; i++) {
+        if (IS_LMS(i))
+            s1[j++] = i;
+    }
+    for (int i = 0; i < n1; i++)
+        sa1[i] = s1[sa1[i]];
+    for (int i = n1; i < n; i++)
+        sa[i] = -1;
+    for (int i = n1 - 1; i >= 0; i--) {
+        int j = sa[i];
+        sa[i] = -1;
+        sa[--bkt[s[j]]] = j;
+    }
+    induceSort(s, sa, type, n, K, bkt);
+
+    free(type);
+    free(bkt);
+}
+
+/*
+ * Function: buildSuffixArray
+ * --------------------------
+ * Fills sa[0..n) with the suffix array of text[0..n) (bytes compared as
+ * unsigned).
+ */
+void buildSuffixArray(const unsigned char *text, int n, int *sa) {
+    if (n == 0)
+        return;
+    int *s = (int *)malloc((n + 1) * sizeof(int));
+    int *full = (int *)malloc((n + 1) * sizeof(int));
+    if (s == NULL || full == NULL) {
+        fprintf(stderr, "Memory allocation failed.\n");
+        exit(EXIT_FAILURE);
+    }
+    for (int i = 0; i < n; i++)
+        s[i] = text[i] + 1;
+    s[n] = 0;  // unique smallest sentinel
+    sais(s, full, n + 1, 257);
+    memcpy(sa, full + 1, n * sizeof(int));  // full[0] is the sentinel suffix
+    free(s);
+    free(full);
+}
+
+/*
+ * Function: buildLCPArray
+ * -----------------------
+ * Kasai's algorithm: lcp[i] = longest common prefix of the suffixes at
+ * sa[i - 1] and sa[i] (lcp[0] = 0).
+ */
+void buildLCPArray(const unsigned char *text, int n, const int *sa, int *lcp) {
+    int *rank = (int *)malloc((n > 0 ? n : 1) * sizeof(int));
+    for (int i = 0; i < n; i++)
+        rank[sa[i]] = i;
+    int h = 0;
+    if (n > 0)
+        lcp[0] = 0;
+    for (int i = 0; i < n; i++) {
+        if (rank[i] > 0) {
+            int j = sa[rank[i] - 1];
+            while (i + h < n && j + h < n && text[i + h] == text[j + h])
+                h++;
+            lcp[rank[i]] = h;
+            if (h > 0)
+                h--;
+        } else {
+            h = 0;
+        }
+    }
+    free(rank);
+}
+
+// -------------------------- Index and queries --------------------------
+typedef struct {
+    int n;
+    unsigned char *text;
+    int *sa;
+    int *lcp;
+} SuffixIndex;
+
+// Compares the first m bytes of the suffix at 'pos' with the pattern.
+static int compareSuffix(const SuffixIndex *idx, int pos, const unsigned char *pattern, int m) {
+    int available = idx->n - pos;
+    int len = available < m ? available : m;
+    int c = memcmp(idx->text + pos, pattern, len);
+    if (c != 0)
+        return c;
+    return (len < m) ? -1 : 0;  // a suffix shorter than the pattern sorts first
+}
+
+/*
+ * Function: findRange
+ * -------------------
+ * Two binary searches over the suffix array: [*lo, *hi) is the block of
+ * suffixes starting with the pattern. Returns the number of occurrences,
+ * hi - lo, without enumerating them.
+ */
+int findRange(const SuffixIndex *idx, const char *pattern, int *lo, int *hi) {
+    const unsigned char *p = (const unsigned char *)pattern;
+    int m = (int)strlen(pattern);
+    int left = 0, right = idx->n;
+    while (left < right) {  // first suffix >= pattern
+        int mid = left + (right - left) / 2;
+        if (compareSuffix(idx, idx->sa[mid], p, m) < 0)
+            left = mid + 1;
+        else
+            right = mid;
+    }
+    *lo = left;
+    right = idx->n;
+    while (left < right) {  // first suffix whose m-prefix > pattern
+        int mid = left + (right - left) / 2;
+        if (compareSuffix(idx, idx->sa[mid], p, m) <= 0)
+            left = mid + 1;
+        else
+            right = mid;
+    }
+    *hi = left;
+    return *hi - *lo;
+}
+
+int writeSuffixIndex(const char *path, const SuffixIndex *idx) {
+    FILE *out = fopen(path, "wb");
+    if (out == NULL) {
+        perror(path);
+        return -1;
+    }
+    uint64_t n = (uint64_t)idx->n;
+    int ok = fwrite(INDEX_MAGIC, 1, 8, out) == 8 &&
+             fwrite(&n, sizeof(n), 1, out) == 1 &&
+             fwrite(idx->text, 1, idx->n, out) == (size_t)idx->n &&
+             fwrite(idx->sa, sizeof(int), idx->n, out) == (size_t)idx->n &&
+             fwrite(idx->lcp, sizeof(int), idx->n, out) == (size_t)idx->n;
+    if (fclose(out) != 0 || !ok) {
+        fprintf(stderr, "Error writing %s.\n", path);
+        return -1;
+    }
+    return 0;
+}
+
+int readSuffixIndex(const char *path, SuffixIndex *idx) {
+    FILE *in = fopen(path, "rb");
+    if (in == NULL) {
+        perror(path);
+        return -1;
+    }
+    char magic[8];
+    uint64_t n;
+    if (fread(magic, 1, 8, in) != 8 || memcmp(magic, INDEX_MAGIC, 8) != 0 ||
+        fread(&n, sizeof(n), 1, in) != 1 || n >= INT32_MAX) {
+        fprintf(stderr, "%s is not a suffix array index.\n", path);
+        fclose(in);
+        return -1;
+    }
+    idx->n = (int)n;
+    idx->text = (unsigned char *)malloc(n + 1);
+    idx->sa = (int *)malloc((n + 1) * sizeof(int));
+    idx->lcp = (int *)malloc((n + 1) * sizeof(int));
+    int ok = idx->text && idx->sa && idx->lcp &&
+             fread(idx->text, 1, n, in) == n &&
+             fread(idx->sa, sizeof(int), n, in) == n &&
+             fread(idx->lcp, sizeof(int), n, in) == n;
+    fclose(in);
+    if (!ok) {
+        fprintf(stderr, "%s is truncated.\n", path);
+        return -1;
+    }
+    return 0;
+}
+
+void freeSuffixIndex(SuffixIndex *idx) {
+    free(idx->text);
+    free(idx->sa);
+    free(idx->lcp);
+}
+
+// Reads a whole file into memory; returns NULL on error.
+unsigned char *readWholeFile(const char *path, long *length) {
+    FILE *in = fopen(path, "rb");
+    if (in == NULL) {
+        perror(path);
+        return NULL;
+    }
+    fseek(in, 0, SEEK_END);
+    *length = ftell(in);
+    fseek(in, 0, SEEK_SET);
+    unsigned char *data = (unsigned char *)malloc(*length > 0 ? *length : 1);
+    if (data == NULL || fread(data, 1, *length, in) != (size_t)*length) {
+        fprintf(stderr, "Error reading %s.\n", path);
+        fclose(in);
+        free(data);
+        return NULL;
+    }
+    fclose(in);
+    return data;
+}
+
+#ifndef SUFFIX_ARRAY_NO_MAIN
+static int compareInts(const void *a, const void *b) {
+    int x = *(const int *)a, y = *(const int *)b;
+    return (x > y) - (x < y);
+}
+
+int main(int argc, char *argv[]) {
+    if (argc >= 4 && strcmp(argv[1], "build") == 0) {
+        long length;
+        SuffixIndex idx;
+        idx.text = readWholeFile(argv[2], &length);
+        if (idx.text == NULL)
+            return EXIT_FAILURE;
+        // n + 1 entries are allocated below, so n itself must stay below INT32_MAX.
+        if (length >= INT32_MAX) {
+            fprintf(stderr, "Text too large for a 32-bit suffix array.\n");
+            return EXIT_FAILURE;
+        }
+        idx.n = (int)length;
+        idx.sa = (int *)malloc((idx.n + 1) * sizeof(int));
+        idx.lcp = (int *)malloc((idx.n + 1) * sizeof(int));
+        if (idx.sa == NULL || idx.lcp == NULL) {
+            fprintf(stderr, "Memory allocation failed.\n");
+            return EXIT_FAILURE;
+        }
+        buildSuffixArray(idx.text, idx.n, idx.sa);
+        buildLCPArray(idx.text, idx.n, idx.sa, idx.lcp);
+        if (writeSuffixIndex(argv[3], &idx) != 0)
+            return EXIT_FAILURE;
+        printf("Indexed %d bytes into %s\n", idx.n, argv[3]);
+        freeSuffixIndex(&idx);
+        return EXIT_SUCCESS;
+    }
+
+    if (argc >= 3 && (strcmp(argv[1], "query") == 0 || strcmp(argv[1], "repeat") == 0)) {
+        SuffixIndex idx;
+        if (readSuffixIndex(argv[2], &idx) != 0)
+            return EXIT_FAILURE;
+
+        if (strcmp(argv[1], "repeat") == 0) {
+            int best = 0;
+            for (int i = 1; i < idx.n; i++) {
+                if (idx.lcp[i] > idx.lcp[best])
+                    best = i;
+            }
+            if (idx.n == 0 || idx.lcp[best] == 0)
+                printf("No repeated substring.\n");
+            else
+                printf("Longest repeated substring (%d bytes) at index %d: \"%.*s\"\n",
+                       idx.lcp[best], idx.sa[best], idx.lcp[best], (const char *)idx.text + idx.sa[best]);
+        } else {
+            int locate = (argc > 3 && strcmp(argv[3], "--locate") == 0);
+            char pattern[4096];
+            while (fgets(pattern, sizeof(pattern), stdin) != NULL) {
+                pattern[strcspn(pattern, "\n")] = '\0';
+                if (pattern[0] == '\0')
+                    continue;
+                int lo, hi;
+                int count = findRange(&idx, pattern, &lo, &hi);
+                printf("Pattern \"%s\": %d occurrence(s)\n", pattern, count);
+                if (locate && count > 0) {
+                    int *positions = (int *)malloc(count * sizeof(int));
+                    memcpy(positions, idx.sa + lo, count * sizeof(int));
+                    qsort(positions, count, sizeof(int), compareInts);
+                    for (int i = 0; i < count; i++)
+                        printf("Pattern found at index %d\n", positions[i]);
+                    free(positions);
+                }
+            }
+        }
+        freeSuffixIndex(&idx);
+        return EXIT_SUCCESS;
+    }
+
+    fprintf(stderr, "Usage: %s build <text-file> <index-file>\n"
+                    "       %s query <index-file> [--locate]\n"
+                    "       %s repeat <index-file>\n", argv[0], argv[0], argv[0]);
+    return EXIT_FAILURE;
+}
+#endif
@@ -0,0 +1,152 @@
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+
+#include "string_match.h"
+
+/*
+ * Crochemore-Perrin Two-Way string matching.
+ *
+ * The pattern x is split at a critical factorisation x = x[0..ell] x[ell+1..m).
+ * Each window is checked right part first (left to right), then left part
+ * (right to left). A mismatch in the right part shifts by how far it got;
+ * a full match shifts by the pattern period. When the pattern is periodic,
+ * 'memory' remembers the prefix already known to match, which keeps the
+ * search linear: at most 2n comparisons, with O(1) extra space (no table at
+ * all, unlike KMP's prefix array or Horspool's shift table).
+ */
+
+/*
+ * Function: maximalSuffix
+ * -----------------------
+ * Start (minus one) of the lexicographically maximal suffix of x[0..m)
+ * under the byte order (reverse = 0) or the reversed order (reverse = 1).
+ * *period receives the period of that suffix.
+ */
+static long maximalSuffix(const unsigned char *x, long m, int reverse, long *period) {
+    long ms = -1, j = 0, k = 1, p = 1;
+    while (j + k < m) {
+        unsigned char a = x[j + k], b = x[ms + k];
+        if (reverse ? a > b : a < b) {
+            j += k;
+            k = 1;
+            p = j - ms;
+        } else if (a == b) {
+            if (k != p) {
+                k++;
+            } else {
+                j += p;
+                k = 1;
+            }
+        } else {
+            ms = j;
+            j = ms + 1;
+            k = p = 1;
+        }
+    }
+    *period = p;
+    return ms;
+}
+
+long long twoWayScan(const char *pattern, size_t patternLength, const char *text, size_t textLength,
+                     MatchCallback report, void *ctx) {
+    const unsigned char *x = (const unsigned char *)pattern;
+    const unsigned char *y = (const unsigned char *)text;
+    long m = (long)patternLength, n = (long)textLength;
+    long long matches = 0;
+    if (m == 0 || m > n)
+        return 0;
+
+    // Critical factorisation: the later of the two maximal suffixes.
+    long p, q;
+    long i = maximalSuffix(x, m, 0, &p);
+    long j = maximalSuffix(x, m, 1, &q);
+    long ell, per;
+    if (i > j) {
+        ell = i;
+        per = p;
+    } else {
+        ell = j;
+        per = q;
+    }
+
+    if (memcmp(x, x + per, ell + 1) == 0) {
+        // Periodic pattern: remember the matched prefix across shifts.
+        long memory = -1;
+        j = 0;
+        while (j <= n - m) {
+            i = (ell > memory ? ell : memory) + 1;
+            while (i < m && x[i] == y[i + j])
+                i++;
+            if (i >= m) {
+                i = ell;
+                while (i > memory && x[i] == y[i + j])
+                    i--;
+                if (i <= memory) {
+                    report((long long)j, ctx);
+                    matches++;
+                }
+                j += per;
+                memory = m - per - 1;
+            } else {
+                j += i - ell;
+                memory = -1;
+            }
+        }
+    } else {
+        // Non-periodic: a shift of max(ell + 1, m - ell - 1) + 1 is safe.
+        per = (ell + 1 > m - ell - 1 ? ell + 1 : m - ell - 1) + 1;
+        j = 0;
+        while (j <= n - m) {
+            i = ell + 1;
+            while (i < m && x[i] == y[i + j])
+                i++;
+            if (i >= m) {
+                i = ell;
+                while (i >= 0 && x[i] == y[i + j])
+                    i--;
+                if (i < 0) {
+                    report((long long)j, ctx);
+                    matches++;
+                }
+                j += per;
+            } else {
+                j += i - ell;
+            }
+        }
+    }
+    return matches;
+}
+
+// Same output contract as KMP().
+void twoWaySearch(const char *pattern, const char *text) {
+    size_t m = strlen(pattern);
+    size_t n = strlen(text);
+    if (m > n) {
+        printf("No occurrences (pattern is longer than text).\n");
+        return;
+    }
+    twoWayScan(pattern, m, text, n, printMatchIndex, NULL);
+}
+
+#ifndef TWO_WAY_NO_MAIN
+int main() {
+    char text[1000];
+    char pattern[1000];
+
+    printf("Enter the text: ");
+    if (fgets(text, sizeof(text), stdin) == NULL) {
+        fprintf(stderr, "Error reading text.\n");
+        return EXIT_FAILURE;
+    }
+    text[strcspn(text, "\n")] = '\0';
+    printf("Enter the pattern: ");
+    if (fgets(pattern, sizeof(pattern), stdin) == NULL) {
+        fprintf(stderr, "Error reading pattern.\n");
+        return EXIT_FAILURE;
+    }
+    pattern[strcspn(pattern, "\n")] = '\0';
+    twoWaySearch(pattern, text);
+    return EXIT_SUCCESS;
+}
+#endif
@@ -0,0 +1,538 @@
+/*
+ * Near-duplicate detection with winnowing fingerprints.
+ *
+ * Every k-gram (k consecutive bytes) of a document is hashed with the
+ * Rabin-Karp rolling hash from rabinKarp.c. From each window of w
+ * consecutive k-gram hashes the minimum is selected (the rightmost one on
+ * ties), and each newly selected hash becomes a fingerprint. Any common
+ * substring of at least w + k - 1 bytes is therefore guaranteed to share a
+ * fingerprint, and no substring shorter than k is ever seen. The window
+ * minimum is kept in a monotonic deque: amortised O(1) per k-gram.
+ *
+ * Each document becomes the set of its distinct fingerprints. An inverted
+ * index maps a fingerprint to the documents containing it. For each
+ * document, walking its fingerprints' posting lists counts the shared
+ * fingerprints with every other document, and pairs whose Jaccard
+ * similarity |A n B| / |A u B| reaches the threshold are reported.
+ * Fingerprints shared by more than --max-postings documents (boilerplate,
+ * licence headers) are left out of the pair counting; this keeps it from
+ * going quadratic.
+ *
+ * Fingerprinting and pair counting both run on --threads threads that
+ * take documents from a shared counter. The hash base is random per
+ * process, so fingerprints can be compared within one run only.
+ *
+ * Usage: ./winnow <file-list> [--k K] [--window W] [--threshold T]
+ *                 [--threads N] [--max-postings P]
+ *        <file-list> holds one path per line ("-" reads it from stdin).
+ * Compile with: gcc -O2 -pthread -o winnow winnow.c
+ */
+#define RABIN_KARP_NO_MAIN
+#include "rabinKarp.c"
+
+#include <pthread.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+typedef struct {
+    uint64_t hash;
+    size_t position;    // offset of the k-gram in the document
+} Fingerprint;
+
+typedef struct {
+    Fingerprint *items;
+    size_t count, capacity;
+} FingerprintList;
+
+static void appendFingerprint(FingerprintList *list, uint64_t hash, size_t position) {
+    if (list->count == list->capacity) {
+        list->capacity = list->capacity ? 2 * list->capacity : 1024;
+        list->items = (Fingerprint *)realloc(list->items, list->capacity * sizeof(Fingerprint));
+        if (list->items == NULL) {
+            fprintf(stderr, "Memory allocation failed.\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+    list->items[list->count].hash = hash;
+    list->items[list->count].position = position;
+    list->count++;
+}
+
+/*
+ * Function: winnow
+ * ----------------
+ * Appends the winnowing fingerprints of text[0..n) to 'out', in text
+ * order. 'rh' must have been set up with initRollingHash(rh, k). 'deque'
+ * is scratch space for w + 1 entries.
+ *
+ * The deque holds k-gram positions of the current window with strictly
+ * increasing hashes from front to back, so its front is the window
+ * minimum. A new hash first evicts every back entry that is not smaller
+ * (keeping the rightmost minimum), and the front entry leaves once it
+ * falls out of the window. A document with fewer than w k-grams gets its
+ * single minimum as a fingerprint.
+ */
+void winnow(const RollingHash *rh, const char *text, size_t n, int k, int w,
+            Fingerprint *deque, FingerprintList *out) {
+    if (n < (size_t)k)
+        return;
+    const unsigned char *t = (const unsigned char *)text;
+    size_t grams = n - (size_t)k + 1;
+    size_t ring = (size_t)w + 1;
+    size_t head = 0, length = 0;        // deque = ring[head .. head + length)
+    size_t lastSelected = (size_t)-1;
+
+    uint64_t hash = 0;
+    for (int i = 0; i < k; i++)
+        hash = hashPush(rh, hash, t[i]);
+
+    for (size_t i = 0; i < grams; i++) {
+        if (i > 0)
+            hash = hashRoll(rh, hash, t[i - 1], t[i + k - 1]);
+
+        while (length > 0 && deque[(head + length - 1) % ring].hash >= hash)
+            length--;
+        deque[(head + length) % ring].hash = hash;
+        deque[(head + length) % ring].position = i;
+        length++;
+        if (deque[head].position + (size_t)w <= i) {
+            head = (head + 1) % ring;
+            length--;
+        }
+
+        if (i + 1 >= (size_t)w && deque[head].position != lastSelected) {
+            lastSelected = deque[head].position;
+            appendFingerprint(out, deque[head].hash, lastSelected);
+        }
+    }
+    if (grams < (size_t)w)
+        appendFingerprint(out, deque[head].hash, deque[head].position);
+}
+
+// ------------------------------- Corpus ---------------------------------
+typedef struct {
+    char *path;
+    uint64_t *prints;   // distinct fingerprints, sorted
+    int count;
+} Document;
+
+typedef struct {
+    Document *docs;
+    int count;
+    int k, w;
+    RollingHash rh;
+    int nextDoc;        // work counter shared by the worker threads
+} Corpus;
+
+static int compareHashes(const void *a, const void *b) {
+    uint64_t x = *(const uint64_t *)a, y = *(const uint64_t *)b;
+    return (x > y) - (x < y);
+}
+
+// Maps a document and reduces its fingerprints to a sorted distinct set.
+static void fingerprintDocument(const Corpus *corpus, Document *doc, Fingerprint *deque,
+                                FingerprintList *scratch) {
+    doc->prints = NULL;
+    doc->count = 0;
+    int fd = open(doc->path, O_RDONLY);
+    struct stat st;
+    if (fd < 0 || fstat(fd, &st) != 0) {
+        perror(doc->path);
+        if (fd >= 0)
+            close(fd);
+        return;
+    }
+    size_t n = (size_t)st.st_size;
+    if (n >= (size_t)corpus->k) {
+        const char *text = (const char *)mmap(NULL, n, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (text == MAP_FAILED) {
+            perror(doc->path);
+            close(fd);
+            return;
+        }
+        scratch->count = 0;
+        winnow(&corpus->rh, text, n, corpus->k, corpus->w, deque, scratch);
+        munmap((void *)text, n);
+    }
+    close(fd);
+    if (n < (size_t)corpus->k || scratch->count == 0)
+        return;
+
+    uint64_t *prints = (uint64_t *)malloc(scratch->count * sizeof(uint64_t));
+    if (prints == NULL) {
+        fprintf(stderr, "Memory allocation failed.\n");
+        exit(EXIT_FAILURE);
+    }
+    for (size_t i = 0; i < scratch->count; i++)
+        prints[i] = scratch->items[i].hash;
+    qsort(prints, scratch->count, sizeof(uint64_t), compareHashes);
+    int distinct = 0;
+    for (size_t i = 0; i < scratch->count; i++) {
+        if (distinct == 0 || prints[distinct - 1] != prints[i])
+            prints[distinct++] = prints[i];
+    }
+    doc->prints = (uint64_t *)realloc(prints, distinct * sizeof(uint64_t));
+    doc->count = distinct;
+}
+
+static void *fingerprintWorker(void *arg) {
+    Corpus *corpus = (Corpus *)arg;
+    Fingerprint *deque = (Fingerprint *)malloc((corpus->w + 1) * sizeof(Fingerprint));
+    FingerprintList scratch = {NULL, 0, 0};
+    if (deque == NULL) {
+        fprintf(stderr, "Memory allocation failed.\n");
+        exit(EXIT_FAILURE);
+    }
+    for (;;) {
+        int d = __atomic_fetch_add(&corpus->nextDoc, 1, __ATOMIC_RELAXED);
+        if (d >= corpus->count)
+            break;
+        fingerprintDocument(corpus, &corpus->docs[d], deque, &scratch);
+    }
+    free(scratch.items);
+    free(deque);
+    return NULL;
+}
+
+/*
+ * Function: fingerprintCorpus
+ * ---------------------------
+ * Fingerprints every document of the corpus on 'threads' threads, which
+ * take documents one at a time from a shared counter so that a few large
+ * files do not leave the other threads idle.
+ */
+void fingerprintCorpus(Corpus *corpus, int threads) {
+    // One RollingHash for the whole corpus; the workers only read it.
+    initRollingHash(&corpus->rh, corpus->k);
+    corpus->nextDoc = 0;
+    pthread_t *ids = (pthread_t *)malloc(threads * sizeof(pthread_t));
+    for (int t = 0; t < threads; t++)
+        pthread_create(&ids[t], NULL, fingerprintWorker, corpus);
+    for (int t = 0; t < threads; t++)
+        pthread_join(ids[t], NULL);
+    free(ids);
+}
+
+// ---------------------------- Inverted index ----------------------------
+// CSR layout: the documents containing keys[i] are docs[start[i] .. start[i+1]),
+// in increasing document order.
+typedef struct {
+    uint64_t *keys;
+    size_t *start;
+    int *docs;
+    size_t keyCount;
+} InvertedIndex;
+
+typedef struct {
+    uint64_t hash;
+    int doc;
+} Posting;
+
+static int comparePostings(const void *a, const void *b) {
+    const Posting *x = (const Posting *)a, *y = (const Posting *)b;
+    if (x->hash != y->hash)
+        return (x->hash > y->hash) - (x->hash < y->hash);
+    return x->doc - y->doc;
+}
+
+void buildInvertedIndex(const Corpus *corpus, InvertedIndex *index) {
+    size_t total = 0;
+    for (int d = 0; d < corpus->count; d++)
+        total += (size_t)corpus->docs[d].count;
+    Posting *postings = (Posting *)malloc((total ? total : 1) * sizeof(Posting));
+    index->keys = (uint64_t *)malloc((total ? total : 1) * sizeof(uint64_t));
+    index->start = (size_t *)malloc((total + 1) * sizeof(size_t));
+    index->docs = (int *)malloc((total ? total : 1) * sizeof(int));
+    if (postings == NULL || index->keys == NULL || index->start == NULL || index->docs == NULL) {
+        fprintf(stderr, "Memory allocation failed.\n");
+        exit(EXIT_FAILURE);
+    }
+    size_t p = 0;
+    for (int d = 0; d < corpus->count; d++) {
+        for (int i = 0; i < corpus->docs[d].count; i++) {
+            postings[p].hash = corpus->docs[d].prints[i];
+            postings[p].doc = d;
+            p++;
+        }
+    }
+    qsort(postings, total, sizeof(Posting), comparePostings);
+
+    index->keyCount = 0;
+    for (size_t i = 0; i < total; i++) {
+        if (i == 0 || postings[i].hash != postings[i - 1].hash) {
+            index->keys[index->keyCount] = postings[i].hash;
+            index->start[index->keyCount] = i;
+            index->keyCount++;
+        }
+        index->docs[i] = postings[i].doc;
+    }
+    index->start[index->keyCount] = total;
+    free(postings);
+}
+
+void freeInvertedIndex(InvertedIndex *index) {
+    free(index->keys);
+    free(index->start);
+    free(index->docs);
+}
+
+// Returns the key slot of 'hash', which must be in the index.
+static size_t findKey(const InvertedIndex *index, uint64_t hash) {
+    size_t lo = 0, hi = index->keyCount;
+    while (lo + 1 < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (index->keys[mid] <= hash)
+            lo = mid;
+        else
+            hi = mid;
+    }
+    return lo;
+}
+
+// ----------------------------- Pair scoring -----------------------------
+typedef struct {
+    int a, b;
+    int shared;
+    double similarity;
+} SimilarPair;
+
+typedef struct {
+    SimilarPair *items;
+    size_t count, capacity;
+} PairList;
+
+typedef struct {
+    const Corpus *corpus;
+    const InvertedIndex *index;
+    double threshold;
+    int maxPostings;
+    int *nextDoc;
+    PairList pairs;
+} ScoreTask;
+
+static void appendPair(PairList *list, int a, int b, int shared, double similarity) {
+    if (list->count == list->capacity) {
+        list->capacity = list->capacity ? 2 * list->capacity : 256;
+        list->items = (SimilarPair *)realloc(list->items, list->capacity * sizeof(SimilarPair));
+        if (list->items == NULL) {
+            fprintf(stderr, "Memory allocation failed.\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+    SimilarPair *pair = &list->items[list->count++];
+    pair->a = a;
+    pair->b = b;
+    pair->shared = shared;
+    pair->similarity = similarity;
+}
+
+/*
+ * For each document a taken from the shared counter, counts the
+ * fingerprints it shares with every document b > a through the posting
+ * lists. The counts live in a dense per-thread array that is reset
+ * through the list of touched documents, so each document costs only
+ * the postings it reaches.
+ */
+static void *scoreWorker(void *arg) {
+    ScoreTask *task = (ScoreTask *)arg;
+    const Corpus *corpus = task->corpus;
+    const InvertedIndex *index = task->index;
+    int *shared = (int *)calloc(corpus->count, sizeof(int));
+    int *touched = (int *)malloc(corpus->count * sizeof(int));
+    if (shared == NULL || touched == NULL) {
+        fprintf(stderr, "Memory allocation failed.\n");
+        exit(EXIT_FAILURE);
+    }
+    for (;;) {
+        int a = __atomic_fetch_add(task->nextDoc, 1, __ATOMIC_RELAXED);
+        if (a >= corpus->count)
+            break;
+        const Document *doc = &corpus->docs[a];
+        int touchedCount = 0;
+        for (int i = 0; i < doc->count; i++) {
+            size_t key = findKey(index, doc->prints[i]);
+            size_t begin = index->start[key], end = index->start[key + 1];
+            if (end - begin > (size_t)task->maxPostings)
+                continue;
+            for (size_t p = begin; p < end; p++) {
+                int b = index->docs[p];
+                if (b <= a)
+                    continue;
+                if (shared[b]++ == 0)
+                    touched[touchedCount++] = b;
+            }
+        }
+        for (int t = 0; t < touchedCount; t++) {
+            int b = touched[t];
+            int common = shared[b];
+            double similarity = (double)common / (doc->count + corpus->docs[b].count - common);
+            if (similarity >= task->threshold)
+                appendPair(&task->pairs, a, b, common, similarity);
+            shared[b] = 0;
+        }
+    }
+    free(shared);
+    free(touched);
+    return NULL;
+}
+
+static int comparePairs(const void *x, const void *y) {
+    const SimilarPair *p = (const SimilarPair *)x, *q = (const SimilarPair *)y;
+    if (p->similarity != q->similarity)
+        return p->similarity < q->similarity ? 1 : -1;
+    if (p->a != q->a)
+        return p->a - q->a;
+    return p->b - q->b;
+}
+
+/*
+ * Function: findSimilarPairs
+ * --------------------------
+ * Scores every document pair that shares at least one fingerprint and
+ * returns those with Jaccard similarity >= threshold in *result, most
+ * similar first.
+ */
+void findSimilarPairs(const Corpus *corpus, const InvertedIndex *index, double threshold,
+                      int maxPostings, int threads, PairList *result) {
+    ScoreTask *tasks = (ScoreTask *)calloc(threads, sizeof(ScoreTask));
+    pthread_t *ids = (pthread_t *)malloc(threads * sizeof(pthread_t));
+    int nextDoc = 0;
+    for (int t = 0; t < threads; t++) {
+        tasks[t].corpus = corpus;
+        tasks[t].index = index;
+        tasks[t].threshold = threshold;
+        tasks[t].maxPostings = maxPostings;
+        tasks[t].nextDoc = &nextDoc;
+        pthread_create(&ids[t], NULL, scoreWorker, &tasks[t]);
+    }
+    result->items = NULL;
+    result->count = result->capacity = 0;
+    for (int t = 0; t < threads; t++) {
+        pthread_join(ids[t], NULL);
+        for (size_t i = 0; i < tasks[t].pairs.count; i++) {
+            const SimilarPair *pair = &tasks[t].pairs.items[i];
+            appendPair(result, pair->a, pair->b, pair->shared, pair->similarity);
+        }
+        free(tasks[t].pairs.items);
+    }
+    if (result->count > 0)
+        qsort(result->items, result->count, sizeof(SimilarPair), comparePairs);
+    free(tasks);
+    free(ids);
+}
+
+#ifndef WINNOW_NO_MAIN
+static double secondsSince(const struct timespec *start) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (now.tv_sec - start->tv_sec) + (now.tv_nsec - start->tv_nsec) * 1e-9;
+}
+
+static int readPathList(const char *listPath, Corpus *corpus) {
+    FILE *in = strcmp(listPath, "-") == 0 ? stdin : fopen(listPath, "r");
+    if (in == NULL) {
+        perror(listPath);
+        return -1;
+    }
+    int capacity = 1024;
+    corpus->docs = (Document *)malloc(capacity * sizeof(Document));
+    corpus->count = 0;
+    char line[4096];
+    while (fgets(line, sizeof(line), in) != NULL) {
+        line[strcspn(line, "\r\n")] = '\0';
+        if (line[0] == '\0')
+            continue;
+        if (corpus->count == capacity) {
+            capacity *= 2;
+            corpus->docs = (Document *)realloc(corpus->docs, capacity * sizeof(Document));
+        }
+        if (corpus->docs == NULL) {
+            fprintf(stderr, "Memory allocation failed.\n");
+            exit(EXIT_FAILURE);
+        }
+        Document *doc = &corpus->docs[corpus->count++];
+        doc->path = (char *)malloc(strlen(line) + 1);
+        strcpy(doc->path, line);
+        doc->prints = NULL;
+        doc->count = 0;
+    }
+    if (in != stdin)
+        fclose(in);
+    return 0;
+}
+
+int main(int argc, char *argv[]) {
+    if (argc < 2) {
+        fprintf(stderr, "Usage: %s <file-list> [--k K] [--window W] [--threshold T]"
+                        " [--threads N] [--max-postings P]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+    Corpus corpus;
+    corpus.k = 25;
+    corpus.w = 40;
+    double threshold = 0.5;
+    int threads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    int maxPostings = 1000;
+    for (int i = 2; i < argc; i++) {
+        if (strcmp(argv[i], "--k") == 0 && i + 1 < argc)
+            corpus.k = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--window") == 0 && i + 1 < argc)
+            corpus.w = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--threshold") == 0 && i + 1 < argc)
+            threshold = atof(argv[++i]);
+        else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc)
+            threads = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--max-postings") == 0 && i + 1 < argc)
+            maxPostings = atoi(argv[++i]);
+    }
+    if (corpus.k < 1 || corpus.w < 1) {
+        fprintf(stderr, "k and window must be positive.\n");
+        return EXIT_FAILURE;
+    }
+    if (threads < 1)
+        threads = 1;
+    if (readPathList(argv[1], &corpus) != 0)
+        return EXIT_FAILURE;
+
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    fingerprintCorpus(&corpus, threads);
+    double fingerprintSeconds = secondsSince(&start);
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    InvertedIndex index;
+    buildInvertedIndex(&corpus, &index);
+    double indexSeconds = secondsSince(&start);
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    PairList pairs;
+    findSimilarPairs(&corpus, &index, threshold, maxPostings, threads, &pairs);
+    double scoreSeconds = secondsSince(&start);
+
+    for (size_t i = 0; i < pairs.count; i++) {
+        const SimilarPair *pair = &pairs.items[i];
+        printf("%.3f  %s  %s  (%d shared)\n", pair->similarity, corpus.docs[pair->a].path,
+               corpus.docs[pair->b].path, pair->shared);
+    }
+
+    size_t totalPrints = index.start[index.keyCount];
+    printf("\nDocuments          : %d\n", corpus.count);
+    printf("Fingerprints       : %zu (%zu distinct)\n", totalPrints, index.keyCount);
+    printf("Similar pairs      : %zu (Jaccard >= %.2f, k = %d, w = %d)\n", pairs.count, threshold,
+           corpus.k, corpus.w);
+    printf("Fingerprinting     : %.3f s (%d threads)\n", fingerprintSeconds, threads);
+    printf("Inverted index     : %.3f s\n", indexSeconds);
+    printf("Pair scoring       : %.3f s\n", scoreSeconds);
+
+    free(pairs.items);
+    freeInvertedIndex(&index);
+    for (int d = 0; d < corpus.count; d++) {
+        free(corpus.docs[d].path);
+        free(corpus.docs[d].prints);
+    }
+    free(corpus.docs);
+    return EXIT_SUCCESS;
+}
+#endif